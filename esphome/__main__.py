@@ -118,6 +118,7 @@ def run_miniterm(config, port):
     import serial
 
     from esphome import platformio_api
+    from esphome.components.logger.deferred_log import get_deferred_log_decoder
 
     if CONF_LOGGER not in config:
         _LOGGER.info("Logger is not enabled. Not starting UART logs.")
@@ -129,6 +130,7 @@ def run_miniterm(config, port):
     _LOGGER.info("Starting log output from %s with baud rate %s", port, baud_rate)
 
     backtrace_state = False
+    deferred_log_decoder = get_deferred_log_decoder(config)
     ser = serial.Serial()
     ser.baudrate = baud_rate
     ser.port = port
@@ -154,6 +156,8 @@ def run_miniterm(config, port):
                         .replace(b"\n", b"")
                         .decode("utf8", "backslashreplace")
                     )
+                    if deferred_log_decoder is not None:
+                        line = deferred_log_decoder.decode(line)
                     time_str = datetime.now().time().strftime("[%H:%M:%S]")
                     message = time_str + line
                     safe_print(message)
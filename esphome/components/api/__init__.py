@@ -49,6 +49,17 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_BATCH_DELAY = "batch_delay"
+CONF_MIN_UPDATE_INTERVAL = "min_update_interval"
+CONF_SEND_QUEUE_SIZE = "send_queue_size"
+CONF_SEND_QUEUE_POLICY = "send_queue_policy"
+
+SendQueuePolicy = api_ns.enum("SendQueuePolicy", is_class=True)
+SEND_QUEUE_POLICIES = {
+    "COALESCE": SendQueuePolicy.COALESCE,
+    "DROP_OLDEST": SendQueuePolicy.DROP_OLDEST,
+    "DISCONNECT": SendQueuePolicy.DISCONNECT,
+}
 
 
 def validate_encryption_key(value):
@@ -91,6 +102,24 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_BATCH_DELAY, default="0ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_MIN_UPDATE_INTERVAL, default="0ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.SplitDefault(
+                CONF_SEND_QUEUE_SIZE,
+                esp8266="2kB",
+                esp32="8kB",
+                rp2040="4kB",
+                bk72xx="4kB",
+                rtl87xx="4kB",
+                host="16kB",
+            ): cv.All(cv.validate_bytes, cv.int_range(min=256)),
+            cv.Optional(CONF_SEND_QUEUE_POLICY, default="COALESCE"): cv.enum(
+                SEND_QUEUE_POLICIES, upper=True
+            ),
             cv.Exclusive(
                 CONF_SERVICES, group_of_exclusion=CONF_ACTIONS
             ): ACTIONS_SCHEMA,
@@ -120,6 +149,11 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
+    cg.add(var.set_min_update_interval(config[CONF_MIN_UPDATE_INTERVAL]))
+    if CONF_SEND_QUEUE_SIZE in config:
+        cg.add(var.set_send_queue_size(config[CONF_SEND_QUEUE_SIZE]))
+    cg.add(var.set_send_queue_policy(config[CONF_SEND_QUEUE_POLICY]))
 
     for conf in config.get(CONF_ACTIONS, []):
         template_args = []
@@ -27,9 +27,11 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+// Write the pending state updates early once they roughly fill a TCP segment
+static const size_t BATCH_FLUSH_SIZE = 1360;
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
-    : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
+    : parent_(parent), initial_state_iterator_(this), dirty_state_iterator_(this), list_entities_iterator_(this) {
   this->proto_write_buffer_.reserve(64);
 
 #if defined(USE_API_PLAINTEXT)
@@ -117,7 +119,9 @@ void APIConnection::loop() {
   }
 
   this->list_entities_iterator_.advance();
+  this->sending_initial_states_ = true;
   this->initial_state_iterator_.advance();
+  this->sending_initial_states_ = false;
 
   static uint32_t keepalive = 60000;
   static uint8_t max_ping_retries = 60;
@@ -152,13 +156,18 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    bool done = this->image_reader_.available() == to_send;
+    uint32_t msg_size = 0;
+    ProtoSize::add_fixed32_field(msg_size, 1, esp32_camera::global_esp32_camera->get_object_id_hash());
+    // the image data is encoded straight from the reader, so account for it by hand: the data field and at most
+    // two bytes for the done field
+    msg_size += ProtoSize::field(2, 2) + ProtoSize::varint(to_send) + to_send + 2;
+    auto buffer = this->create_buffer(msg_size);
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
     // bytes data = 2;
     buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
     // bool done = 3;
-    bool done = this->image_reader_.available() == to_send;
     buffer.encode_bool(3, done);
     bool success = this->send_buffer(buffer, 44);
 
@@ -186,6 +195,60 @@ void APIConnection::loop() {
       }
     }
   }
+
+  // while the client is backlogged the dirty states would only be dropped from the send queue again
+  if (this->has_dirty_states_ && !this->backlogged_ &&
+      millis() - this->last_state_flush_ >= this->min_update_interval_) {
+    this->flush_dirty_states_();
+  }
+
+  if (!this->batch_packets_.empty() && millis() - this->batch_start_ >= this->parent_->get_batch_delay()) {
+    this->flush_batch_();
+  }
+}
+
+void APIConnection::subscribe_states(const SubscribeStatesRequest &msg) {
+  this->state_subscription_ = true;
+  this->min_update_interval_ =
+      msg.min_update_interval != 0 ? msg.min_update_interval : this->parent_->get_min_update_interval();
+  if (this->min_update_interval_ != 0)
+    this->dirty_states_.assign(App.get_entity_count(), false);
+  this->initial_state_iterator_.begin();
+}
+bool APIConnection::hold_state_(EntityBase *entity) {
+  const uint16_t index = entity->get_entity_index();
+  this->batch_entity_ = index;
+  if (this->flushing_dirty_states_) {
+    // only entities that changed since the last flush are sent, with their current state
+    if (!this->dirty_states_[index])
+      return true;
+    this->dirty_states_[index] = false;
+    return false;
+  }
+  if (this->min_update_interval_ == 0 || this->sending_initial_states_) {
+    // this update supersedes a state that was dropped from the send queue
+    if (!this->dirty_states_.empty())
+      this->dirty_states_[index] = false;
+    return false;
+  }
+  this->mark_state_dirty_(index);
+  return true;
+}
+void APIConnection::mark_state_dirty_(uint16_t entity_index) {
+  if (this->dirty_states_.empty())
+    this->dirty_states_.assign(App.get_entity_count(), false);
+  this->dirty_states_[entity_index] = true;
+  this->has_dirty_states_ = true;
+}
+void APIConnection::flush_dirty_states_() {
+  this->has_dirty_states_ = false;
+  this->last_state_flush_ = millis();
+  this->flushing_dirty_states_ = true;
+  this->dirty_state_iterator_.begin();
+  // state updates go into the batch and only fail once the connection is closed, so this visits every entity
+  while (!this->dirty_state_iterator_.completed() && !this->remove_)
+    this->dirty_state_iterator_.advance();
+  this->flushing_dirty_states_ = false;
 }
 
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
@@ -209,12 +272,14 @@ void APIConnection::on_disconnect_response(const DisconnectResponse &value) {
 bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(binary_sensor))
+    return true;
 
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  return this->send_batched_(&APIConnection::send_binary_sensor_state_response, resp);
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
@@ -236,6 +301,8 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(cover))
+    return true;
 
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
@@ -246,7 +313,7 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  return this->send_batched_(&APIConnection::send_cover_state_response, resp);
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
@@ -299,6 +366,8 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 bool APIConnection::send_fan_state(fan::Fan *fan) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(fan))
+    return true;
 
   auto traits = fan->get_traits();
   FanStateResponse resp{};
@@ -313,7 +382,7 @@ bool APIConnection::send_fan_state(fan::Fan *fan) {
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
   if (traits.supports_preset_modes())
     resp.preset_mode = fan->preset_mode;
-  return this->send_fan_state_response(resp);
+  return this->send_batched_(&APIConnection::send_fan_state_response, resp);
 }
 bool APIConnection::send_fan_info(fan::Fan *fan) {
   auto traits = fan->get_traits();
@@ -360,6 +429,8 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 bool APIConnection::send_light_state(light::LightState *light) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(light))
+    return true;
 
   auto traits = light->get_traits();
   auto values = light->remote_values;
@@ -380,7 +451,7 @@ bool APIConnection::send_light_state(light::LightState *light) {
   resp.warm_white = values.get_warm_white();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  return this->send_batched_(&APIConnection::send_light_state_response, resp);
 }
 bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
@@ -458,12 +529,14 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(sensor))
+    return true;
 
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  return this->send_batched_(&APIConnection::send_sensor_state_response, resp);
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
@@ -490,11 +563,13 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(a_switch))
+    return true;
 
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
-  return this->send_switch_state_response(resp);
+  return this->send_batched_(&APIConnection::send_switch_state_response, resp);
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
@@ -527,12 +602,14 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(text_sensor))
+    return true;
 
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !text_sensor->has_state();
-  return this->send_text_sensor_state_response(resp);
+  return this->send_batched_(&APIConnection::send_text_sensor_state_response, resp);
 }
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
@@ -554,6 +631,8 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 bool APIConnection::send_climate_state(climate::Climate *climate) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(climate))
+    return true;
 
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
@@ -583,7 +662,7 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.current_humidity = climate->current_humidity;
   if (traits.get_supports_target_humidity())
     resp.target_humidity = climate->target_humidity;
-  return this->send_climate_state_response(resp);
+  return this->send_batched_(&APIConnection::send_climate_state_response, resp);
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
@@ -662,12 +741,14 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
 bool APIConnection::send_number_state(number::Number *number, float state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(number))
+    return true;
 
   NumberStateResponse resp{};
   resp.key = number->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !number->has_state();
-  return this->send_number_state_response(resp);
+  return this->send_batched_(&APIConnection::send_number_state_response, resp);
 }
 bool APIConnection::send_number_info(number::Number *number) {
   ListEntitiesNumberResponse msg;
@@ -704,6 +785,8 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
 bool APIConnection::send_date_state(datetime::DateEntity *date) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(date))
+    return true;
 
   DateStateResponse resp{};
   resp.key = date->get_object_id_hash();
@@ -711,7 +794,7 @@ bool APIConnection::send_date_state(datetime::DateEntity *date) {
   resp.year = date->year;
   resp.month = date->month;
   resp.day = date->day;
-  return this->send_date_state_response(resp);
+  return this->send_batched_(&APIConnection::send_date_state_response, resp);
 }
 bool APIConnection::send_date_info(datetime::DateEntity *date) {
   ListEntitiesDateResponse msg;
@@ -741,6 +824,8 @@ void APIConnection::date_command(const DateCommandRequest &msg) {
 bool APIConnection::send_time_state(datetime::TimeEntity *time) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(time))
+    return true;
 
   TimeStateResponse resp{};
   resp.key = time->get_object_id_hash();
@@ -748,7 +833,7 @@ bool APIConnection::send_time_state(datetime::TimeEntity *time) {
   resp.hour = time->hour;
   resp.minute = time->minute;
   resp.second = time->second;
-  return this->send_time_state_response(resp);
+  return this->send_batched_(&APIConnection::send_time_state_response, resp);
 }
 bool APIConnection::send_time_info(datetime::TimeEntity *time) {
   ListEntitiesTimeResponse msg;
@@ -778,6 +863,8 @@ void APIConnection::time_command(const TimeCommandRequest &msg) {
 bool APIConnection::send_datetime_state(datetime::DateTimeEntity *datetime) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(datetime))
+    return true;
 
   DateTimeStateResponse resp{};
   resp.key = datetime->get_object_id_hash();
@@ -786,7 +873,7 @@ bool APIConnection::send_datetime_state(datetime::DateTimeEntity *datetime) {
     ESPTime state = datetime->state_as_esptime();
     resp.epoch_seconds = state.timestamp;
   }
-  return this->send_date_time_state_response(resp);
+  return this->send_batched_(&APIConnection::send_date_time_state_response, resp);
 }
 bool APIConnection::send_datetime_info(datetime::DateTimeEntity *datetime) {
   ListEntitiesDateTimeResponse msg;
@@ -816,12 +903,14 @@ void APIConnection::datetime_command(const DateTimeCommandRequest &msg) {
 bool APIConnection::send_text_state(text::Text *text, std::string state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(text))
+    return true;
 
   TextStateResponse resp{};
   resp.key = text->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !text->has_state();
-  return this->send_text_state_response(resp);
+  return this->send_batched_(&APIConnection::send_text_state_response, resp);
 }
 bool APIConnection::send_text_info(text::Text *text) {
   ListEntitiesTextResponse msg;
@@ -854,12 +943,14 @@ void APIConnection::text_command(const TextCommandRequest &msg) {
 bool APIConnection::send_select_state(select::Select *select, std::string state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(select))
+    return true;
 
   SelectStateResponse resp{};
   resp.key = select->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !select->has_state();
-  return this->send_select_state_response(resp);
+  return this->send_batched_(&APIConnection::send_select_state_response, resp);
 }
 bool APIConnection::send_select_info(select::Select *select) {
   ListEntitiesSelectResponse msg;
@@ -915,11 +1006,13 @@ void APIConnection::button_command(const ButtonCommandRequest &msg) {
 bool APIConnection::send_lock_state(lock::Lock *a_lock, lock::LockState state) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(a_lock))
+    return true;
 
   LockStateResponse resp{};
   resp.key = a_lock->get_object_id_hash();
   resp.state = static_cast<enums::LockState>(state);
-  return this->send_lock_state_response(resp);
+  return this->send_batched_(&APIConnection::send_lock_state_response, resp);
 }
 bool APIConnection::send_lock_info(lock::Lock *a_lock) {
   ListEntitiesLockResponse msg;
@@ -959,12 +1052,14 @@ void APIConnection::lock_command(const LockCommandRequest &msg) {
 bool APIConnection::send_valve_state(valve::Valve *valve) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(valve))
+    return true;
 
   ValveStateResponse resp{};
   resp.key = valve->get_object_id_hash();
   resp.position = valve->position;
   resp.current_operation = static_cast<enums::ValveOperation>(valve->current_operation);
-  return this->send_valve_state_response(resp);
+  return this->send_batched_(&APIConnection::send_valve_state_response, resp);
 }
 bool APIConnection::send_valve_info(valve::Valve *valve) {
   auto traits = valve->get_traits();
@@ -1001,6 +1096,8 @@ void APIConnection::valve_command(const ValveCommandRequest &msg) {
 bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_player) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(media_player))
+    return true;
 
   MediaPlayerStateResponse resp{};
   resp.key = media_player->get_object_id_hash();
@@ -1011,7 +1108,7 @@ bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_pla
   resp.state = static_cast<enums::MediaPlayerState>(report_state);
   resp.volume = media_player->volume;
   resp.muted = media_player->is_muted();
-  return this->send_media_player_state_response(resp);
+  return this->send_batched_(&APIConnection::send_media_player_state_response, resp);
 }
 bool APIConnection::send_media_player_info(media_player::MediaPlayer *media_player) {
   ListEntitiesMediaPlayerResponse msg;
@@ -1092,7 +1189,7 @@ void APIConnection::camera_image(const CameraImageRequest &msg) {
   if (msg.stream) {
     esp32_camera::global_esp32_camera->start_stream(esphome::esp32_camera::API_REQUESTER);
 
-    App.scheduler.set_timeout(this->parent_, "api_esp32_camera_stop_stream", ESP32_CAMERA_STOP_STREAM, []() {
+    App.scheduler.set_timeout_literal(this->parent_, "api_esp32_camera_stop_stream", ESP32_CAMERA_STOP_STREAM, []() {
       esp32_camera::global_esp32_camera->stop_stream(esphome::esp32_camera::API_REQUESTER);
     });
   }
@@ -1267,11 +1364,13 @@ void APIConnection::voice_assistant_set_configuration(const VoiceAssistantSetCon
 bool APIConnection::send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(a_alarm_control_panel))
+    return true;
 
   AlarmControlPanelStateResponse resp{};
   resp.key = a_alarm_control_panel->get_object_id_hash();
   resp.state = static_cast<enums::AlarmControlPanelState>(a_alarm_control_panel->get_state());
-  return this->send_alarm_control_panel_state_response(resp);
+  return this->send_batched_(&APIConnection::send_alarm_control_panel_state_response, resp);
 }
 bool APIConnection::send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   ListEntitiesAlarmControlPanelResponse msg;
@@ -1349,6 +1448,8 @@ bool APIConnection::send_event_info(event::Event *event) {
 bool APIConnection::send_update_state(update::UpdateEntity *update) {
   if (!this->state_subscription_)
     return false;
+  if (this->hold_state_(update))
+    return true;
 
   UpdateStateResponse resp{};
   resp.key = update->get_object_id_hash();
@@ -1366,7 +1467,7 @@ bool APIConnection::send_update_state(update::UpdateEntity *update) {
     resp.release_url = update->update_info.release_url;
   }
 
-  return this->send_update_state_response(resp);
+  return this->send_batched_(&APIConnection::send_update_state_response, resp);
 }
 bool APIConnection::send_update_info(update::UpdateEntity *update) {
   ListEntitiesUpdateResponse msg;
@@ -1403,18 +1504,51 @@ void APIConnection::update_command(const UpdateCommandRequest &msg) {
 }
 #endif
 
+#ifdef USE_RUNTIME_STATS
+void APIConnection::component_runtime_stats(const ComponentRuntimeStatsRequest &msg) {
+  ComponentRuntimeStatsResponse resp{};
+  resp.uptime_ms = millis();
+  resp.idle_time_us = App.get_idle_time_us();
+  const auto &components = App.get_components();
+  resp.components.reserve(components.size());
+  for (auto *component : components) {
+    const auto &stats = component->get_runtime_stats();
+    ComponentRuntimeStatsEntry entry{};
+    entry.source = component->get_component_source();
+    entry.loop_count = stats.loop_count;
+    entry.loop_time_us = stats.loop_time_us;
+    entry.loop_max_us = stats.loop_max_us;
+    entry.scheduler_count = stats.scheduler_count;
+    entry.scheduler_time_us = stats.scheduler_time_us;
+    entry.scheduler_max_us = stats.scheduler_max_us;
+    resp.components.push_back(std::move(entry));
+  }
+  this->send_component_runtime_stats_response(resp);
+}
+#endif
+
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
 
+  const size_t line_length = strlen(line);
+  uint32_t msg_size = 0;
+  ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(level));
+  msg_size += ProtoSize::field(3, 2) + ProtoSize::varint(static_cast<uint32_t>(line_length)) + line_length;
+
+  // Logs can be emitted while a state update is being batched, they are never part of the batch
+  const bool batching = this->batching_;
+  this->batching_ = false;
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  auto buffer = this->create_buffer(msg_size);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_length);
   // SubscribeLogsResponse - 29
-  return this->send_buffer(buffer, 29);
+  bool success = this->send_buffer(buffer, 29);
+  this->batching_ = batching;
+  return success;
 }
 
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
@@ -1516,29 +1650,174 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
-bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
-  if (this->remove_)
+ProtoWriteBuffer APIConnection::create_buffer(uint32_t reserve_size) {
+  // FIXME: ensure no recursive writes can happen
+  // Leave room for the frame header in front of and the frame footer after the message so the frame helper can
+  // finish the packet in place
+  const uint8_t header_padding = this->helper_->frame_header_padding();
+  const size_t packet_size = header_padding + reserve_size + this->helper_->frame_footer_size();
+  if (this->batching_) {
+    std::vector<uint8_t> &batch = this->batch_buffer_;
+    this->batch_packet_offset_ = batch.size();
+    if (batch.size() + packet_size > batch.capacity())
+      batch.reserve(std::max(batch.size() + packet_size, batch.capacity() * 2));
+    batch.resize(batch.size() + header_padding);
+    return {&batch};
+  }
+  this->proto_write_buffer_.clear();
+  this->proto_write_buffer_.reserve(packet_size);
+  this->proto_write_buffer_.resize(header_padding);
+  return {&this->proto_write_buffer_};
+}
+bool APIConnection::wait_for_write_space_(uint32_t message_type) {
+  if (this->helper_->can_write_without_blocking())
+    return true;
+  delay(0);
+  APIError err = this->helper_->loop();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", this->client_combined_info_.c_str(),
+             api_error_to_str(err), errno);
     return false;
+  }
   if (!this->helper_->can_write_without_blocking()) {
-    delay(0);
-    APIError err = this->helper_->loop();
-    if (err != APIError::OK) {
-      on_fatal_error();
-      ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", this->client_combined_info_.c_str(),
-               api_error_to_str(err), errno);
-      return false;
+    // SubscribeLogsResponse
+    if (message_type != 29) {
+      ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
     }
-    if (!this->helper_->can_write_without_blocking()) {
-      // SubscribeLogsResponse
-      if (message_type != 29) {
-        ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
+    delay(0);
+    return false;
+  }
+  return true;
+}
+bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
+  if (this->remove_)
+    return false;
+
+  if (buffer.get_buffer() == &this->batch_buffer_) {
+    const uint32_t offset = this->batch_packet_offset_;
+    const uint32_t payload_size = this->batch_buffer_.size() - offset - this->helper_->frame_header_padding();
+    this->batch_buffer_.resize(this->batch_buffer_.size() + this->helper_->frame_footer_size());
+    if (this->batch_packets_.empty())
+      this->batch_start_ = millis();
+
+    if (this->parent_->get_send_queue_policy() == SendQueuePolicy::COALESCE) {
+      // only the latest state of an entity is worth sending, replace the one that is still queued
+      for (size_t i = this->batch_packets_.size(); i-- > this->batch_head_;) {
+        if (this->batch_entities_[i] == this->batch_entity_ && this->batch_packets_[i].message_type == message_type) {
+          this->remove_batched_packet_(i);
+          this->parent_->record_coalesced_message();
+          break;
+        }
       }
-      delay(0);
-      return false;
     }
+    const PacketInfo packet{static_cast<uint16_t>(message_type), offset, payload_size};
+    this->batch_packets_.push_back(packet);
+    this->batch_entities_.push_back(this->batch_entity_);
+    this->batch_live_size_ += this->batch_packet_size_(packet);
+
+    if (this->batch_live_size_ > this->parent_->get_send_queue_size() && !this->enforce_send_queue_size_())
+      return false;
+    // reclaim the space of dropped packets once it outgrows the packets that are still queued
+    if (this->batch_buffer_.size() - this->batch_live_size_ > this->batch_live_size_)
+      this->compact_batch_();
+    if (this->batch_live_size_ >= BATCH_FLUSH_SIZE)
+      this->flush_batch_();
+    return true;
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  // keep the order of messages, batched state updates go out first. Not for SubscribeLogsResponse, logs may be
+  // emitted while the batch is being flushed
+  if ((message_type != 29 && !this->batch_packets_.empty() && !this->flush_batch_()) ||
+      !this->wait_for_write_space_(message_type))
+    return false;
+
+  // Do not set last_traffic_ on send
+  return this->handle_write_result_(this->helper_->write_protobuf_packet(message_type, buffer));
+}
+bool APIConnection::flush_batch_() {
+  if (!this->wait_for_write_space_(this->batch_packets_.front().message_type)) {
+    // keep the batch until the client catches up, the send queue size bounds how much is kept
+    this->backlogged_ = true;
+    return false;
+  }
+  this->backlogged_ = false;
+  // the frame helpers expect the packets back to back
+  if (this->batch_live_size_ != this->batch_buffer_.size())
+    this->compact_batch_();
+  APIError err = this->helper_->write_protobuf_packets(
+      ProtoWriteBuffer(&this->batch_buffer_), this->batch_packets_.data(), this->batch_packets_.size());
+  // the buffers keep their capacity for the next batch
+  this->batch_buffer_.clear();
+  this->batch_packets_.clear();
+  this->batch_entities_.clear();
+  this->batch_head_ = 0;
+  this->batch_live_size_ = 0;
+  return this->handle_write_result_(err);
+}
+bool APIConnection::enforce_send_queue_size_() {
+  if (this->parent_->get_send_queue_policy() == SendQueuePolicy::DISCONNECT) {
+    this->on_fatal_error();
+    ESP_LOGW(TAG, "%s: Send queue is full, disconnecting", this->client_combined_info_.c_str());
+    return false;
+  }
+  const uint32_t send_queue_size = this->parent_->get_send_queue_size();
+  const size_t newest = this->batch_packets_.size() - 1;
+  uint32_t dropped = 0;
+  // an update with a newer state of the same entity queued behind it is not needed anymore
+  for (size_t i = this->batch_head_; i < newest && this->batch_live_size_ > send_queue_size; i++) {
+    if (this->batch_packets_[i].message_type == 0)
+      continue;
+    for (size_t j = i + 1; j <= newest; j++) {
+      if (this->batch_packets_[j].message_type != 0 && this->batch_entities_[j] == this->batch_entities_[i]) {
+        this->remove_batched_packet_(i);
+        dropped++;
+        break;
+      }
+    }
+  }
+  // then drop the oldest updates, but never the one that was just queued. Their entities are sent again with
+  // their current state once the client catches up
+  while (this->batch_live_size_ > send_queue_size && this->batch_head_ < newest) {
+    this->mark_state_dirty_(this->batch_entities_[this->batch_head_]);
+    this->remove_batched_packet_(this->batch_head_);
+    dropped++;
+  }
+  ESP_LOGV(TAG, "%s: Send queue is full, dropped %" PRIu32 " state updates", this->client_combined_info_.c_str(),
+           dropped);
+  this->parent_->record_dropped_messages(dropped);
+  return true;
+}
+void APIConnection::remove_batched_packet_(size_t index) {
+  PacketInfo &packet = this->batch_packets_[index];
+  this->batch_live_size_ -= this->batch_packet_size_(packet);
+  packet.message_type = 0;
+  while (this->batch_head_ < this->batch_packets_.size() && this->batch_packets_[this->batch_head_].message_type == 0)
+    this->batch_head_++;
+}
+void APIConnection::compact_batch_() {
+  uint8_t *data = this->batch_buffer_.data();
+  uint32_t size = 0;
+  size_t count = 0;
+  for (size_t i = this->batch_head_; i < this->batch_packets_.size(); i++) {
+    PacketInfo packet = this->batch_packets_[i];
+    if (packet.message_type == 0)
+      continue;
+    const uint32_t packet_size = this->batch_packet_size_(packet);
+    if (packet.offset != size)
+      memmove(data + size, data + packet.offset, packet_size);
+    packet.offset = size;
+    this->batch_packets_[count] = packet;
+    this->batch_entities_[count] = this->batch_entities_[i];
+    count++;
+    size += packet_size;
+  }
+  this->batch_buffer_.resize(size);
+  this->batch_packets_.resize(count);
+  this->batch_entities_.resize(count);
+  this->batch_head_ = 0;
+}
+bool APIConnection::handle_write_result_(APIError err) {
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -1551,7 +1830,6 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
     return false;
   }
-  // Do not set last_traffic_ on send
   return true;
 }
 void APIConnection::on_unauthenticated_access() {
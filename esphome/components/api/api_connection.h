@@ -175,6 +175,10 @@ class APIConnection : public APIServerConnection {
   void update_command(const UpdateCommandRequest &msg) override;
 #endif
 
+#ifdef USE_RUNTIME_STATS
+  void component_runtime_stats(const ComponentRuntimeStatsRequest &msg) override;
+#endif
+
   void on_disconnect_response(const DisconnectResponse &value) override;
   void on_ping_response(const PingResponse &value) override {
     // we initiated ping
@@ -191,10 +195,7 @@ class APIConnection : public APIServerConnection {
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
   void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
-  void subscribe_states(const SubscribeStatesRequest &msg) override {
-    this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
-  }
+  void subscribe_states(const SubscribeStatesRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
     if (msg.dump_config)
@@ -217,11 +218,7 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
-    // FIXME: ensure no recursive writes can happen
-    this->proto_write_buffer_.clear();
-    return {&this->proto_write_buffer_};
-  }
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override;
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
 
   std::string get_client_combined_info() const { return this->client_combined_info_; }
@@ -231,6 +228,48 @@ class APIConnection : public APIServerConnection {
 
   bool send_(const void *buf, size_t len, bool force);
 
+  /** Whether a state update of this entity is held back by the minimum update interval of the subscription.
+   *
+   * Held back entities are marked dirty and their latest state is sent by the next flush_dirty_states_(). Also
+   * remembers the entity for the send_batched_() call that follows when the update is not held back.
+   */
+  bool hold_state_(EntityBase *entity);
+  /// Mark an entity dirty so its current state is sent by the next flush_dirty_states_().
+  void mark_state_dirty_(uint16_t entity_index);
+  /// Send the current state of every entity that changed since the last flush.
+  void flush_dirty_states_();
+
+  /** Send a state response together with the other state updates of this loop iteration.
+   *
+   * The message is encoded into the batch buffer and written along with the rest of the batch once the batch delay
+   * has passed, the batch is full or another message is sent. The packet belongs to the entity passed to the
+   * preceding hold_state_().
+   */
+  template<class C> bool send_batched_(bool (APIServerConnectionBase::*send)(const C &), const C &msg) {
+    this->batching_ = true;
+    bool ret = (this->*send)(msg);
+    this->batching_ = false;
+    return ret;
+  }
+  /// Wait for the socket to accept more data, returns false if it is still blocked.
+  bool wait_for_write_space_(uint32_t message_type);
+  /// Write all batched messages, returns false if the socket is blocked and they stay queued.
+  bool flush_batch_();
+  /** Apply the send queue policy once the batch grew past the send queue size, returns false on disconnect.
+   *
+   * Packets superseded by a newer queued state of the same entity are dropped first. Past that the oldest packets
+   * are dropped and their entities marked dirty, so their current state is sent once the client catches up.
+   */
+  bool enforce_send_queue_size_();
+  /// Drop a batched packet. Its bytes stay in the batch buffer until the next compact_batch_().
+  void remove_batched_packet_(size_t index);
+  /// Move the remaining batched packets to the front of the batch buffer, over the bytes of dropped ones.
+  void compact_batch_();
+  uint32_t batch_packet_size_(const PacketInfo &packet) const {
+    return this->helper_->frame_header_padding() + packet.payload_size + this->helper_->frame_footer_size();
+  }
+  bool handle_write_result_(APIError err);
+
   enum class ConnectionState {
     WAITING_FOR_HELLO,
     CONNECTED,
@@ -242,6 +281,22 @@ class APIConnection : public APIServerConnection {
   // Buffer used to encode proto messages
   // Re-use to prevent allocations
   std::vector<uint8_t> proto_write_buffer_;
+  // Batched state updates, each laid out as frame header padding, message and frame footer
+  std::vector<uint8_t> batch_buffer_;
+  /// Batched packets in send order, dropped ones are kept with a message type of 0 until the batch is compacted
+  std::vector<PacketInfo> batch_packets_;
+  /// Entity index of every batched packet, see EntityBase::get_entity_index()
+  std::vector<uint16_t> batch_entities_;
+  /// Index of the oldest batched packet that was not dropped
+  size_t batch_head_{0};
+  /// Bytes of the batch buffer used by packets that were not dropped
+  uint32_t batch_live_size_{0};
+  uint16_t batch_entity_{0};
+  uint32_t batch_start_{0};
+  uint32_t batch_packet_offset_{0};
+  bool batching_{false};
+  /// The last batch could not be written because the client is not reading fast enough
+  bool backlogged_{false};
   std::unique_ptr<APIFrameHelper> helper_;
 
   std::string client_info_;
@@ -254,6 +309,14 @@ class APIConnection : public APIServerConnection {
 #endif
 
   bool state_subscription_{false};
+  /// Minimum interval between two state updates of an entity for this subscription, 0 sends every update.
+  uint32_t min_update_interval_{0};
+  uint32_t last_state_flush_{0};
+  /// Entities with a held back or dropped state update, indexed by EntityBase::get_entity_index().
+  std::vector<bool> dirty_states_;
+  bool has_dirty_states_{false};
+  bool flushing_dirty_states_{false};
+  bool sending_initial_states_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
   uint32_t last_traffic_;
   uint32_t next_ping_retry_{0};
@@ -263,6 +326,8 @@ class APIConnection : public APIServerConnection {
   bool next_close_ = false;
   APIServer *parent_;
   InitialStateIterator initial_state_iterator_;
+  /// Sends the held back state updates, see flush_dirty_states_().
+  InitialStateIterator dirty_state_iterator_;
   ListEntitiesIterator list_entities_iterator_;
   int state_subs_at_ = -1;
 };
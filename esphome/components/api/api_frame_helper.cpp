@@ -20,6 +20,49 @@ bool is_would_block(ssize_t ret) {
   return ret == 0;
 }
 
+// Maximum number of queued chunks handed to a single writev() call
+static const int MAX_TX_IOVS = 16;
+
+/// Copy what was not sent of iov, skipping the first skip bytes, into a new chunk at the end of the queue.
+static void queue_unsent(std::deque<SendBuffer> &queue, const struct iovec *iov, int iovcnt, size_t skip,
+                         size_t total_len) {
+  queue.emplace_back();
+  std::vector<uint8_t> &data = queue.back().data;
+  data.reserve(total_len - skip);
+  for (int i = 0; i < iovcnt; i++) {
+    if (skip >= iov[i].iov_len) {
+      skip -= iov[i].iov_len;
+      continue;
+    }
+    const uint8_t *base = reinterpret_cast<const uint8_t *>(iov[i].iov_base);
+    data.insert(data.end(), base + skip, base + iov[i].iov_len);
+    skip = 0;
+  }
+}
+
+/// Point iov at the front chunks of the queue, returns the number of entries used.
+static int queue_to_iovs(std::deque<SendBuffer> &queue, struct iovec *iov) {
+  int iovcnt = 0;
+  for (auto it = queue.begin(); it != queue.end() && iovcnt < MAX_TX_IOVS; ++it, ++iovcnt) {
+    iov[iovcnt].iov_base = it->current_data();
+    iov[iovcnt].iov_len = it->remaining();
+  }
+  return iovcnt;
+}
+
+/// Advance past sent bytes, dropping chunks that were sent completely.
+static void consume_queue(std::deque<SendBuffer> &queue, size_t sent) {
+  while (sent > 0) {
+    SendBuffer &front = queue.front();
+    if (sent < front.remaining()) {
+      front.offset += sent;
+      return;
+    }
+    sent -= front.remaining();
+    queue.pop_front();
+  }
+}
+
 const char *api_error_to_str(APIError err) {
   // not using switch to ensure compiler doesn't try to build a big table out of it
   if (err == APIError::OK) {
@@ -76,6 +119,14 @@ const char *api_error_to_str(APIError err) {
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
 
+APIError APIFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  PacketInfo packet{type, 0, static_cast<uint32_t>(raw_buffer->size() - frame_header_padding_)};
+  // make room for the footer, this does not reallocate when it was reserved up front
+  raw_buffer->resize(raw_buffer->size() + frame_footer_size_);
+  return this->write_protobuf_packets(buffer, &packet, 1);
+}
+
 #ifdef USE_API_NOISE
 static const char *const PROLOGUE_INIT = "NoiseAPIInit";
 
@@ -467,7 +518,8 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APINoiseFrameHelper::write_protobuf_packets(ProtoWriteBuffer buffer, const PacketInfo *packets,
+                                                     size_t count) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -478,45 +530,49 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   if (state_ != State::DATA) {
     return APIError::WOULD_BLOCK;
   }
+  if (count == 0) {
+    return APIError::OK;
+  }
 
-  size_t padding = 0;
-  size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
-
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
-  const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  uint8_t *buffer_data = buffer.get_buffer()->data();
+  size_t total_len = 0;
+  for (size_t i = 0; i < count; i++) {
+    const PacketInfo &packet = packets[i];
+    uint8_t *buf = buffer_data + packet.offset;
+    size_t msg_len = 4 + packet.payload_size;
+
+    buf[0] = 0x01;  // indicator
+    // buf[1], buf[2] to be set later
+    const uint8_t msg_offset = 3;
+    buf[msg_offset + 0] = (uint8_t) (packet.message_type >> 8);  // type
+    buf[msg_offset + 1] = (uint8_t) packet.message_type;
+    buf[msg_offset + 2] = (uint8_t) (packet.payload_size >> 8);  // data_len
+    buf[msg_offset + 3] = (uint8_t) packet.payload_size;
+
+    // encrypt in place, the MAC goes into the reserved footer
+    NoiseBuffer mbuf;
+    noise_buffer_init(mbuf);
+    noise_buffer_set_inout(mbuf, buf + msg_offset, msg_len, msg_len + frame_footer_size_);
+    err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
+    if (err != 0) {
+      state_ = State::FAILED;
+      HELPER_LOG("noise_cipherstate_encrypt failed: %s", noise_err_to_str(err).c_str());
+      return APIError::CIPHERSTATE_ENCRYPT_FAILED;
+    }
+    if (mbuf.size != msg_len + frame_footer_size_) {
+      // the frames must fill their reserved space exactly to be sent as one block
+      state_ = State::FAILED;
+      HELPER_LOG("Unexpected encrypted size %u", (unsigned) mbuf.size);
+      return APIError::CIPHERSTATE_ENCRYPT_FAILED;
+    }
 
-  NoiseBuffer mbuf;
-  noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
-  err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
-  if (err != 0) {
-    state_ = State::FAILED;
-    HELPER_LOG("noise_cipherstate_encrypt failed: %s", noise_err_to_str(err).c_str());
-    return APIError::CIPHERSTATE_ENCRYPT_FAILED;
+    buf[1] = (uint8_t) (mbuf.size >> 8);
+    buf[2] = (uint8_t) mbuf.size;
+    total_len += 3 + mbuf.size;
   }
 
-  size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t) (mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
-
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
+  iov.iov_base = buffer_data + packets[0].offset;
   iov.iov_len = total_len;
 
   // write raw to not have two packets sent if NAGLE disabled
@@ -524,20 +580,19 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
 }
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
+  struct iovec iov[MAX_TX_IOVS];
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
-    if (sent == -1) {
-      if (errno == EWOULDBLOCK || errno == EAGAIN)
-        break;
+    int iovcnt = queue_to_iovs(tx_buf_, iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
+    if (is_would_block(sent)) {
+      break;
+    } else if (sent == -1) {
       state_ = State::FAILED;
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
-    } else if (sent == 0) {
-      break;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    // partial writes only advance the cursor of the front chunk
+    consume_queue(tx_buf_, sent);
   }
 
   return APIError::OK;
@@ -570,20 +625,14 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
 
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_unsent(tx_buf_, iov, iovcnt, 0, total_write_len);
     return APIError::OK;
   }
 
   ssize_t sent = socket_->writev(iov, iovcnt);
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_unsent(tx_buf_, iov, iovcnt, 0, total_write_len);
     return APIError::OK;
   } else if (sent == -1) {
     // an error occurred
@@ -592,16 +641,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     return APIError::SOCKET_WRITE_FAILED;
   } else if ((size_t) sent != total_write_len) {
     // partially sent, add end to tx_buf
-    size_t to_consume = sent;
-    for (int i = 0; i < iovcnt; i++) {
-      if (to_consume >= iov[i].iov_len) {
-        to_consume -= iov[i].iov_len;
-      } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-        to_consume = 0;
-      }
-    }
+    queue_unsent(tx_buf_, iov, iovcnt, sent, total_write_len);
     return APIError::OK;
   }
   // fully sent
@@ -693,6 +733,8 @@ APIError APINoiseFrameHelper::check_handshake_finished_() {
     return APIError::HANDSHAKESTATE_SPLIT_FAILED;
   }
 
+  frame_footer_size_ = noise_cipherstate_get_mac_length(send_cipher_);
+
   HELPER_LOG("Handshake complete!");
   noise_handshakestate_free(handshake_);
   handshake_ = nullptr;
@@ -903,31 +945,45 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APIPlaintextFrameHelper::write_protobuf_packets(ProtoWriteBuffer buffer, const PacketInfo *packets,
+                                                         size_t count) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
+  if (count == 0) {
+    return APIError::OK;
+  }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
-
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  if (payload_len == 0) {
-    return write_raw_(iov, 1);
+  uint8_t *buffer_data = buffer.get_buffer()->data();
+  this->tx_iovs_.clear();
+  for (size_t i = 0; i < count; i++) {
+    const PacketInfo &packet = packets[i];
+    // the header varints have a variable length, so right-align the header against the message
+    size_t header_len = 1 + ProtoSize::varint(packet.payload_size) + ProtoSize::varint(uint32_t(packet.message_type));
+    if (header_len > frame_header_padding_) {
+      HELPER_LOG("Packet too large to frame: %u bytes", (unsigned) packet.payload_size);
+      return APIError::BAD_ARG;
+    }
+    uint8_t *header = buffer_data + packet.offset + frame_header_padding_ - header_len;
+    header[0] = 0x00;  // indicator
+    size_t pos = 1;
+    pos += ProtoVarInt(packet.payload_size).encode(header + pos);
+    ProtoVarInt(packet.message_type).encode(header + pos);
+
+    struct iovec iov;
+    iov.iov_base = header;
+    iov.iov_len = header_len + packet.payload_size;
+    this->tx_iovs_.push_back(iov);
   }
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
 
-  return write_raw_(iov, 2);
+  return write_raw_(this->tx_iovs_.data(), this->tx_iovs_.size());
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
+  struct iovec iov[MAX_TX_IOVS];
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    int iovcnt = queue_to_iovs(tx_buf_, iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
     if (is_would_block(sent)) {
       break;
     } else if (sent == -1) {
@@ -935,9 +991,8 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    // partial writes only advance the cursor of the front chunk
+    consume_queue(tx_buf_, sent);
   }
 
   return APIError::OK;
@@ -970,20 +1025,14 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
 
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_unsent(tx_buf_, iov, iovcnt, 0, total_write_len);
     return APIError::OK;
   }
 
   ssize_t sent = socket_->writev(iov, iovcnt);
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_unsent(tx_buf_, iov, iovcnt, 0, total_write_len);
     return APIError::OK;
   } else if (sent == -1) {
     // an error occurred
@@ -992,16 +1041,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
     return APIError::SOCKET_WRITE_FAILED;
   } else if ((size_t) sent != total_write_len) {
     // partially sent, add end to tx_buf
-    size_t to_consume = sent;
-    for (int i = 0; i < iovcnt; i++) {
-      if (to_consume >= iov[i].iov_len) {
-        to_consume -= iov[i].iov_len;
-      } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-        to_consume = 0;
-      }
-    }
+    queue_unsent(tx_buf_, iov, iovcnt, sent, total_write_len);
     return APIError::OK;
   }
   // fully sent
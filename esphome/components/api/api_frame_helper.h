@@ -11,6 +11,7 @@
 #endif
 
 #include "api_noise_context.h"
+#include "proto.h"
 #include "esphome/components/socket/socket.h"
 
 namespace esphome {
@@ -30,6 +31,23 @@ struct PacketBuffer {
   uint8_t data_len;
 };
 
+/// Data that could not be written to the socket yet, offset is how much of it has been written since.
+struct SendBuffer {
+  std::vector<uint8_t> data;
+  size_t offset{0};
+
+  uint8_t *current_data() { return this->data.data() + this->offset; }
+  size_t remaining() const { return this->data.size() - this->offset; }
+};
+
+/// Location of one encoded message inside a buffer holding several messages.
+struct PacketInfo {
+  uint16_t message_type;
+  /// Start of the reserved frame header in front of the message
+  uint32_t offset;
+  uint32_t payload_size;
+};
+
 enum class APIError : int {
   OK = 0,
   WOULD_BLOCK = 1001,
@@ -65,26 +83,49 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Frame and send a protobuf message that was encoded in place.
+   *
+   * The buffer must start with frame_header_padding() reserved bytes followed by the encoded message. The frame
+   * header (and, for noise, the MAC after the message) is written directly into that buffer, so the message is never
+   * copied.
+   */
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer);
+  /** Frame and send several encoded messages with a single socket write.
+   *
+   * Each message is laid out as frame_header_padding() bytes, the encoded message and frame_footer_size() bytes,
+   * back to back in the order of packets.
+   */
+  virtual APIError write_protobuf_packets(ProtoWriteBuffer buffer, const PacketInfo *packets, size_t count) = 0;
+  /// Number of bytes to reserve in front of an encoded message for the frame header.
+  uint8_t frame_header_padding() const { return this->frame_header_padding_; }
+  /// Number of bytes to reserve after an encoded message for the frame footer.
+  uint8_t frame_footer_size() const { return this->frame_footer_size_; }
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+
+ protected:
+  uint8_t frame_header_padding_{0};
+  uint8_t frame_footer_size_{0};
 };
 
 #ifdef USE_API_NOISE
 class APINoiseFrameHelper : public APIFrameHelper {
  public:
   APINoiseFrameHelper(std::unique_ptr<socket::Socket> socket, std::shared_ptr<APINoiseContext> ctx)
-      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {}
+      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {
+    // 3 byte frame header (indicator + encrypted size) + 2 byte type + 2 byte data length
+    this->frame_header_padding_ = 7;
+  }
   ~APINoiseFrameHelper() override;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packets(ProtoWriteBuffer buffer, const PacketInfo *packets, size_t count) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -116,7 +157,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  std::deque<SendBuffer> tx_buf_;
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -141,13 +182,16 @@ class APINoiseFrameHelper : public APIFrameHelper {
 #ifdef USE_API_PLAINTEXT
 class APIPlaintextFrameHelper : public APIFrameHelper {
  public:
-  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {}
+  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {
+    // 1 byte indicator + up to 3 byte size varint + up to 2 byte type varint
+    this->frame_header_padding_ = 6;
+  }
   ~APIPlaintextFrameHelper() override = default;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packets(ProtoWriteBuffer buffer, const PacketInfo *packets, size_t count) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -177,7 +221,9 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  std::deque<SendBuffer> tx_buf_;
+  // Re-use to prevent allocations when writing batches
+  std::vector<struct iovec> tx_iovs_;
 
   enum class State {
     INITIALIZE = 1,
@@ -652,6 +652,16 @@ bool APIServerConnectionBase::send_update_state_response(const UpdateStateRespon
 #endif
 #ifdef USE_UPDATE
 #endif
+#ifdef USE_RUNTIME_STATS
+#endif
+#ifdef USE_RUNTIME_STATS
+bool APIServerConnectionBase::send_component_runtime_stats_response(const ComponentRuntimeStatsResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_component_runtime_stats_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<ComponentRuntimeStatsResponse>(msg, 125);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -1191,6 +1201,17 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       ESP_LOGVV(TAG, "on_voice_assistant_set_configuration: %s", msg.dump().c_str());
 #endif
       this->on_voice_assistant_set_configuration(msg);
+#endif
+      break;
+    }
+    case 124: {
+#ifdef USE_RUNTIME_STATS
+      ComponentRuntimeStatsRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_component_runtime_stats_request: %s", msg.dump().c_str());
+#endif
+      this->on_component_runtime_stats_request(msg);
 #endif
       break;
     }
@@ -1723,6 +1744,19 @@ void APIServerConnection::on_alarm_control_panel_command_request(const AlarmCont
   this->alarm_control_panel_command(msg);
 }
 #endif
+#ifdef USE_RUNTIME_STATS
+void APIServerConnection::on_component_runtime_stats_request(const ComponentRuntimeStatsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->component_runtime_stats(msg);
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
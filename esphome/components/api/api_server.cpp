@@ -1,6 +1,7 @@
 #include "api_server.h"
 #ifdef USE_API
 #include <cerrno>
+#include <cinttypes>
 #include "api_connection.h"
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
@@ -66,6 +67,10 @@ void APIServer::setup() {
     this->mark_failed();
     return;
   }
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  // a connecting client wakes the loop while it is idle
+  App.register_socket_wake(this->socket_->get_fd(), this);
+#endif
 
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
@@ -135,6 +140,18 @@ void APIServer::loop() {
       this->status_clear_warning();
     }
   }
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (this->clients_.empty() && this->socket_->get_fd() >= 0) {
+    // nothing to do until a client connects or the reboot timeout expires
+    if (this->reboot_timeout_ != 0) {
+      const uint32_t elapsed = millis() - this->last_connected_;
+      const uint32_t remaining = elapsed < this->reboot_timeout_ ? this->reboot_timeout_ - elapsed + 1 : 0;
+      this->set_timeout_literal("reboot_timeout", remaining, [this]() { this->enable_loop(); });
+    }
+    this->disable_loop();
+  }
+#endif
 }
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
@@ -144,6 +161,11 @@ void APIServer::dump_config() {
 #else
   ESP_LOGCONFIG(TAG, "  Using noise encryption: NO");
 #endif
+  ESP_LOGCONFIG(TAG, "  State update batch delay: %" PRIu32 " ms", this->batch_delay_);
+  if (this->min_update_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Minimum state update interval: %" PRIu32 " ms", this->min_update_interval_);
+  }
+  ESP_LOGCONFIG(TAG, "  Send queue size: %" PRIu32 " bytes", this->send_queue_size_);
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
@@ -387,6 +409,10 @@ void APIServer::request_time() {
 #endif
 bool APIServer::is_connected() const { return !this->clients_.empty(); }
 void APIServer::on_shutdown() {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (this->socket_ != nullptr)
+    App.unregister_socket_wake(this->socket_->get_fd());
+#endif
   for (auto &c : this->clients_) {
     c->send_disconnect_request(DisconnectRequest());
   }
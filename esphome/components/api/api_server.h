@@ -19,6 +19,16 @@
 namespace esphome {
 namespace api {
 
+/// What a connection does when its queued state updates exceed the send queue size.
+enum class SendQueuePolicy : uint8_t {
+  /// Replace a queued update of an entity with its newer state, then drop the oldest and resend those entities later
+  COALESCE,
+  /// Drop queued updates superseded by a newer one, then the oldest and resend those entities later
+  DROP_OLDEST,
+  /// Disconnect the client
+  DISCONNECT,
+};
+
 class APIServer : public Component, public Controller {
  public:
   APIServer();
@@ -33,6 +43,24 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// How long state updates may be held back to be sent together with later ones, 0 sends them once per loop.
+  void set_batch_delay(uint32_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint32_t get_batch_delay() const { return this->batch_delay_; }
+  /// Minimum interval between two state updates of an entity for clients that do not request their own, 0 disables.
+  void set_min_update_interval(uint32_t min_update_interval) { this->min_update_interval_ = min_update_interval; }
+  uint32_t get_min_update_interval() const { return this->min_update_interval_; }
+  /// Maximum number of bytes of state updates a connection may queue while the client is not reading.
+  void set_send_queue_size(uint32_t send_queue_size) { this->send_queue_size_ = send_queue_size; }
+  uint32_t get_send_queue_size() const { return this->send_queue_size_; }
+  void set_send_queue_policy(SendQueuePolicy send_queue_policy) { this->send_queue_policy_ = send_queue_policy; }
+  SendQueuePolicy get_send_queue_policy() const { return this->send_queue_policy_; }
+
+  /// Number of messages that were not sent to a client because it could not keep up, over all connections.
+  uint32_t get_dropped_messages() const { return this->dropped_messages_; }
+  /// Number of queued state updates that were replaced by a newer state of the same entity.
+  uint32_t get_coalesced_messages() const { return this->coalesced_messages_; }
+  void record_dropped_messages(uint32_t count) { this->dropped_messages_ += count; }
+  void record_coalesced_message() { this->coalesced_messages_++; }
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -132,6 +160,12 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint32_t batch_delay_{0};
+  uint32_t min_update_interval_{0};
+  uint32_t send_queue_size_{4096};
+  SendQueuePolicy send_queue_policy_{SendQueuePolicy::COALESCE};
+  uint32_t dropped_messages_{0};
+  uint32_t coalesced_messages_{0};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
@@ -87,6 +87,22 @@ class ProtoVarInt {
       }
     }
   }
+  /** Encode the varint into a raw buffer.
+   *
+   * The caller must make sure there is room for at least ProtoSize::varint() bytes.
+   *
+   * @return The number of bytes written.
+   */
+  size_t encode(uint8_t *out) const {
+    uint64_t val = this->value_;
+    size_t i = 0;
+    do {
+      uint8_t temp = val & 0x7F;
+      val >>= 7;
+      out[i++] = val ? (temp | 0x80) : temp;
+    } while (val);
+    return i;
+  }
 
  protected:
   uint64_t value_;
@@ -255,15 +271,11 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // the nested length is known up front, so the message can be encoded once without shifting it afterwards
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -271,10 +283,122 @@ class ProtoWriteBuffer {
   std::vector<uint8_t> *buffer_;
 };
 
+/** Helpers to compute the encoded size of a message without encoding it.
+ *
+ * Every add_*_field() method mirrors the matching ProtoWriteBuffer::encode_*() method, including which values
+ * are skipped, so that ProtoMessage::calculate_size() returns exactly the number of bytes encode() writes.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) {
+    if (value < (1 << 7))
+      return 1;
+    if (value < (1 << 14))
+      return 2;
+    if (value < (1 << 21))
+      return 3;
+    if (value < (1 << 28))
+      return 4;
+    return 5;
+  }
+  static uint32_t varint(uint64_t value) {
+    uint32_t size = 1;
+    while (value >= 0x80) {
+      value >>= 7;
+      size++;
+    }
+    return size;
+  }
+  static uint32_t field(uint32_t field_id, uint32_t type) { return varint((field_id << 3) | (type & 0b111)); }
+
+  static void add_string_field(uint32_t &total_size, uint32_t field_id, const std::string &value, bool force = false) {
+    // encode_string() never writes empty strings
+    if (value.empty())
+      return;
+    total_size += field(field_id, 2) + varint(static_cast<uint32_t>(value.size())) + value.size();
+  }
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field(field_id, 0) + 1;
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_fixed64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 8;
+  }
+  template<typename T>
+  static void add_enum_field(uint32_t &total_size, uint32_t field_id, T value, bool force = false) {
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    union {
+      float value;
+      uint32_t raw;
+    } val{};
+    val.value = value;
+    add_fixed32_field(total_size, field_id, val.raw);
+  }
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      add_int64_field(total_size, field_id, value, force);
+      return;
+    }
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    uint32_t uvalue;
+    if (value < 0) {
+      uvalue = ~(value << 1);
+    } else {
+      uvalue = value << 1;
+    }
+    add_uint32_field(total_size, field_id, uvalue, force);
+  }
+  static void add_sint64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    uint64_t uvalue;
+    if (value < 0) {
+      uvalue = ~(value << 1);
+    } else {
+      uvalue = value << 1;
+    }
+    add_uint64_field(total_size, field_id, uvalue, force);
+  }
+  template<class C>
+  static void add_message_field(uint32_t &total_size, uint32_t field_id, const C &value, bool force = false) {
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    total_size += field(field_id, 2) + varint(nested_length) + nested_length;
+  }
+};
+
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() will write to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -298,12 +422,18 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /** Get a buffer to encode a message into.
+   *
+   * @param reserve_size The expected size of the encoded message, so that encoding does not need to reallocate.
+   */
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -11,7 +11,10 @@ namespace b_parasite {
 
 class BParasite : public Component, public esp32_ble_tracker::ESPBTDeviceListener {
  public:
-  void set_address(uint64_t address) { address_ = address; };
+  void set_address(uint64_t address) {
+    address_ = address;
+    this->add_filter_address(address);
+  };
   void set_bindkey(const std::string &bindkey);
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
@@ -28,9 +28,11 @@ void Filter::input(bool value, bool is_initial) {
 
 optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON_OFF", this->on_delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
+    this->set_timeout_literal("ON_OFF", this->on_delay_.value(),
+                              [this, is_initial]() { this->output(true, is_initial); });
   } else {
-    this->set_timeout("ON_OFF", this->off_delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
+    this->set_timeout_literal("ON_OFF", this->off_delay_.value(),
+                              [this, is_initial]() { this->output(false, is_initial); });
   }
   return {};
 }
@@ -39,7 +41,7 @@ float DelayedOnOffFilter::get_setup_priority() const { return setup_priority::HA
 
 optional<bool> DelayedOnFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON", this->delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
+    this->set_timeout_literal("ON", this->delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
     return {};
   } else {
     this->cancel_timeout("ON");
@@ -51,7 +53,7 @@ float DelayedOnFilter::get_setup_priority() const { return setup_priority::HARDW
 
 optional<bool> DelayedOffFilter::new_value(bool value, bool is_initial) {
   if (!value) {
-    this->set_timeout("OFF", this->delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
+    this->set_timeout_literal("OFF", this->delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
     return {};
   } else {
     this->cancel_timeout("OFF");
@@ -87,7 +89,7 @@ void AutorepeatFilter::next_timing_() {
   // 2nd time: starts waiting the second delay and starts toggling with the first time_off / _on
   // last time: no delay to start but have to bump the index to reflect the last
   if (this->active_timing_ < this->timings_.size())
-    this->set_timeout("TIMING", this->timings_[this->active_timing_].delay, [this]() { this->next_timing_(); });
+    this->set_timeout_literal("TIMING", this->timings_[this->active_timing_].delay, [this]() { this->next_timing_(); });
 
   if (this->active_timing_ <= this->timings_.size()) {
     this->active_timing_++;
@@ -102,7 +104,8 @@ void AutorepeatFilter::next_timing_() {
 void AutorepeatFilter::next_value_(bool val) {
   const AutorepeatFilterTiming &timing = this->timings_[this->active_timing_ - 2];
   this->output(val, false);  // This is at least the second one so not initial
-  this->set_timeout("ON_OFF", val ? timing.time_on : timing.time_off, [this, val]() { this->next_value_(!val); });
+  this->set_timeout_literal("ON_OFF", val ? timing.time_on : timing.time_off,
+                            [this, val]() { this->next_value_(!val); });
 }
 
 float AutorepeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
@@ -113,7 +116,7 @@ optional<bool> LambdaFilter::new_value(bool value, bool is_initial) { return thi
 
 optional<bool> SettleFilter::new_value(bool value, bool is_initial) {
   if (!this->steady_) {
-    this->set_timeout("SETTLE", this->delay_.value(), [this, value, is_initial]() {
+    this->set_timeout_literal("SETTLE", this->delay_.value(), [this, value, is_initial]() {
       this->steady_ = true;
       this->output(value, is_initial);
     });
@@ -121,7 +124,7 @@ optional<bool> SettleFilter::new_value(bool value, bool is_initial) {
   } else {
     this->steady_ = false;
     this->output(value, is_initial);
-    this->set_timeout("SETTLE", this->delay_.value(), [this]() { this->steady_ = true; });
+    this->set_timeout_literal("SETTLE", this->delay_.value(), [this]() { this->steady_ = true; });
     return value;
   }
 }
@@ -10,6 +10,9 @@ CODEOWNERS = ["@jesserockz"]
 
 CONF_CACHE_SERVICES = "cache_services"
 CONF_CONNECTIONS = "connections"
+CONF_ADVERTISEMENT_BATCH_SIZE = "advertisement_batch_size"
+CONF_ADVERTISEMENT_BATCH_WINDOW = "advertisement_batch_window"
+CONF_ADVERTISEMENT_DEDUP_INTERVAL = "advertisement_dedup_interval"
 MAX_CONNECTIONS = 3
 
 bluetooth_proxy_ns = cg.esphome_ns.namespace("bluetooth_proxy")
@@ -56,6 +59,15 @@ CONFIG_SCHEMA = cv.All(
                 cv.ensure_list(CONNECTION_SCHEMA),
                 cv.Length(min=1, max=MAX_CONNECTIONS),
             ),
+            cv.Optional(CONF_ADVERTISEMENT_BATCH_SIZE, default=16): cv.int_range(
+                min=1, max=32
+            ),
+            cv.Optional(
+                CONF_ADVERTISEMENT_BATCH_WINDOW, default="0ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_ADVERTISEMENT_DEDUP_INTERVAL, default="0ms"
+            ): cv.positive_time_period_milliseconds,
         }
     )
     .extend(esp32_ble_tracker.ESP_BLE_DEVICE_SCHEMA)
@@ -69,6 +81,11 @@ async def to_code(config):
     await cg.register_component(var, config)
 
     cg.add(var.set_active(config[CONF_ACTIVE]))
+    cg.add(var.set_advertisement_batch_size(config[CONF_ADVERTISEMENT_BATCH_SIZE]))
+    cg.add(var.set_advertisement_batch_window(config[CONF_ADVERTISEMENT_BATCH_WINDOW]))
+    cg.add(
+        var.set_advertisement_dedup_interval(config[CONF_ADVERTISEMENT_DEDUP_INTERVAL])
+    )
     await esp32_ble_tracker.register_ble_device(var, config)
 
     for connection_conf in config.get(CONF_CONNECTIONS, []):
@@ -10,6 +10,8 @@ namespace bluetooth_proxy {
 
 static const char *const TAG = "bluetooth_proxy";
 static const int DONE_SENDING_SERVICES = -2;
+/// How many recently sent advertisements are remembered to drop their unchanged repeats.
+static const uint8_t RECENT_ADVERTISEMENTS = 32;
 
 std::vector<uint64_t> get_128bit_uuid_vec(esp_bt_uuid_t uuid_source) {
   esp_bt_uuid_t uuid = espbt::ESPBTUUID::from_uuid(uuid_source).as_128bit().get_uuid();
@@ -39,28 +41,116 @@ bool BluetoothProxy::parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_p
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr || !this->raw_advertisements_)
     return false;
 
-  api::BluetoothLERawAdvertisementsResponse resp;
-  for (size_t i = 0; i < count; i++) {
-    auto &result = advertisements[i];
-    api::BluetoothLERawAdvertisement adv;
-    adv.address = esp32_ble::ble_addr_to_uint64(result.bda);
-    adv.rssi = result.rssi;
-    adv.address_type = result.ble_addr_type;
-
-    uint8_t length = result.adv_data_len + result.scan_rsp_len;
-    adv.data.reserve(length);
-    for (uint16_t i = 0; i < length; i++) {
-      adv.data.push_back(result.ble_adv[i]);
-    }
+  for (size_t i = 0; i < count; i++)
+    this->queue_advertisement_(advertisements[i]);
+  if (this->advertisement_batch_window_ == 0)
+    this->flush_advertisements_();
+  return true;
+}
 
-    resp.advertisements.push_back(std::move(adv));
+static uint8_t raw_advertisement_length(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result) {
+  return std::min<uint8_t>(result.adv_data_len + result.scan_rsp_len, sizeof(result.ble_adv));
+}
 
-    ESP_LOGV(TAG, "Proxying raw packet from %02X:%02X:%02X:%02X:%02X:%02X, length %d. RSSI: %d dB", result.bda[0],
-             result.bda[1], result.bda[2], result.bda[3], result.bda[4], result.bda[5], length, result.rssi);
+/// Key of an advertisement in recent_advertisements_, it changes with the address and with the payload.
+static uint64_t raw_advertisement_key(uint64_t address, const uint8_t *data, uint8_t length) {
+  uint64_t hash = 14695981039346656037ULL ^ address;
+  for (uint8_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
   }
-  ESP_LOGV(TAG, "Proxying %d packets", count);
-  this->api_connection_->send_bluetooth_le_raw_advertisements_response(resp);
-  return true;
+  return hash;
+}
+
+void BluetoothProxy::queue_advertisement_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result) {
+  const uint64_t address = esp32_ble::ble_addr_to_uint64(result.bda);
+  const uint8_t length = raw_advertisement_length(result);
+
+  // a device repeating the same advertisement only needs to be sent once in a while
+  const uint32_t now = millis();
+  if (this->advertisement_dedup_interval_ != 0 &&
+      this->is_recent_advertisement_(raw_advertisement_key(address, result.ble_adv, length), now))
+    return;
+  ESP_LOGV(TAG, "Proxying raw packet from %02X:%02X:%02X:%02X:%02X:%02X, length %d. RSSI: %d dB", result.bda[0],
+           result.bda[1], result.bda[2], result.bda[3], result.bda[4], result.bda[5], length, result.rssi);
+
+  if (this->pending_advertisements_.size() >= this->advertisement_batch_size_)
+    this->flush_advertisements_();
+  if (this->pending_advertisements_.empty())
+    this->advertisement_batch_start_ = now;
+  if (this->advertisement_batch_window_ == 0) {
+    // sent before parse_devices() returns, while the tracker still holds the scan result
+    this->pending_advertisements_.push_back(&result);
+  } else {
+    // reserved for a full batch in setup(), so the pending pointers stay valid
+    this->held_advertisements_.push_back(result);
+    this->pending_advertisements_.push_back(&this->held_advertisements_.back());
+  }
+}
+
+bool BluetoothProxy::is_recent_advertisement_(uint64_t key, uint32_t now) {
+  for (auto &recent : this->recent_advertisements_) {
+    if (recent.key != key)
+      continue;
+    if (now - recent.sent < this->advertisement_dedup_interval_)
+      return true;
+    recent.sent = now;
+    return false;
+  }
+  // replace the advertisement that was remembered first
+  this->recent_advertisements_[this->recent_advertisement_next_] = {key, now};
+  this->recent_advertisement_next_ = (this->recent_advertisement_next_ + 1) % this->recent_advertisements_.size();
+  return false;
+}
+
+static uint32_t raw_advertisement_size(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result) {
+  const uint8_t data_len = raw_advertisement_length(result);
+  uint32_t size = 0;
+  api::ProtoSize::add_uint64_field(size, 1, esp32_ble::ble_addr_to_uint64(result.bda));
+  api::ProtoSize::add_sint32_field(size, 2, result.rssi);
+  api::ProtoSize::add_uint32_field(size, 3, result.ble_addr_type);
+  if (data_len > 0)
+    size += api::ProtoSize::field(4, 2) + api::ProtoSize::varint(static_cast<uint32_t>(data_len)) + data_len;
+  return size;
+}
+
+void BluetoothProxy::clear_pending_advertisements_() {
+  this->pending_advertisements_.clear();
+  this->held_advertisements_.clear();
+}
+
+void BluetoothProxy::flush_advertisements_() {
+  if (this->pending_advertisements_.empty())
+    return;
+  if (this->api_connection_ == nullptr || !this->raw_advertisements_) {
+    this->clear_pending_advertisements_();
+    return;
+  }
+
+  // encodes the same frame as a BluetoothLERawAdvertisementsResponse, without building one first
+  uint32_t msg_size = 0;
+  for (const auto *pending : this->pending_advertisements_) {
+    const uint32_t size = raw_advertisement_size(*pending);
+    msg_size += api::ProtoSize::field(1, 2) + api::ProtoSize::varint(size) + size;
+  }
+  auto buffer = this->api_connection_->create_buffer(msg_size);
+  for (const auto *pending : this->pending_advertisements_) {
+    // repeated BluetoothLERawAdvertisement advertisements = 1;
+    buffer.encode_field_raw(1, 2);
+    buffer.encode_varint_raw(raw_advertisement_size(*pending));
+    // uint64 address = 1;
+    buffer.encode_uint64(1, esp32_ble::ble_addr_to_uint64(pending->bda));
+    // sint32 rssi = 2;
+    buffer.encode_sint32(2, pending->rssi);
+    // uint32 address_type = 3;
+    buffer.encode_uint32(3, pending->ble_addr_type);
+    // bytes data = 4;
+    buffer.encode_bytes(4, pending->ble_adv, raw_advertisement_length(*pending));
+  }
+  ESP_LOGV(TAG, "Proxying %d packets", this->pending_advertisements_.size());
+  // BluetoothLERawAdvertisementsResponse - 93
+  this->api_connection_->send_buffer(buffer, 93);
+  this->clear_pending_advertisements_();
 }
 void BluetoothProxy::send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device) {
   api::BluetoothLEAdvertisementResponse resp;
@@ -92,6 +182,8 @@ void BluetoothProxy::dump_config() {
   ESP_LOGCONFIG(TAG, "  Active: %s", YESNO(this->active_));
   ESP_LOGCONFIG(TAG, "  Connections: %d", this->connections_.size());
   ESP_LOGCONFIG(TAG, "  Raw advertisements: %s", YESNO(this->raw_advertisements_));
+  ESP_LOGCONFIG(TAG, "  Advertisement batch: %u advertisements, %" PRIu32 " ms", this->advertisement_batch_size_,
+                this->advertisement_batch_window_);
 }
 
 int BluetoothProxy::get_bluetooth_connections_free() {
@@ -108,6 +200,14 @@ int BluetoothProxy::get_bluetooth_connections_free() {
   return free;
 }
 
+void BluetoothProxy::setup() {
+  this->pending_advertisements_.reserve(this->advertisement_batch_size_);
+  if (this->advertisement_batch_window_ != 0)
+    this->held_advertisements_.reserve(this->advertisement_batch_size_);
+  if (this->advertisement_dedup_interval_ != 0)
+    this->recent_advertisements_.resize(RECENT_ADVERTISEMENTS);
+}
+
 void BluetoothProxy::loop() {
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr) {
     for (auto *connection : this->connections_) {
@@ -115,8 +215,12 @@ void BluetoothProxy::loop() {
         connection->disconnect();
       }
     }
+    this->clear_pending_advertisements_();
     return;
   }
+  if (!this->pending_advertisements_.empty() &&
+      millis() - this->advertisement_batch_start_ >= this->advertisement_batch_window_)
+    this->flush_advertisements_();
   for (auto *connection : this->connections_) {
     if (connection->send_service_ == connection->service_count_) {
       connection->send_service_ = DONE_SENDING_SERVICES;
@@ -456,6 +560,7 @@ void BluetoothProxy::unsubscribe_api_connection(api::APIConnection *api_connecti
   }
   this->api_connection_ = nullptr;
   this->raw_advertisements_ = false;
+  this->clear_pending_advertisements_();
   this->parent_->recalculate_advertisement_parser_types();
 }
 
@@ -49,6 +49,7 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   BluetoothProxy();
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
   bool parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_param *advertisements, size_t count) override;
+  void setup() override;
   void dump_config() override;
   void loop() override;
   esp32_ble_tracker::AdvertisementParserType get_advertisement_parser_type() override;
@@ -91,6 +92,15 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   }
 
   void set_active(bool active) { this->active_ = active; }
+  /// Send raw advertisements once this many are pending.
+  void set_advertisement_batch_size(uint8_t batch_size) { this->advertisement_batch_size_ = batch_size; }
+  /// Hold raw advertisements back for up to this many ms to send them together, 0 sends every batch of scan results
+  /// right away.
+  void set_advertisement_batch_window(uint32_t batch_window) { this->advertisement_batch_window_ = batch_window; }
+  /// Drop repeats of an unchanged raw advertisement for this many ms after it was sent, 0 sends every repeat.
+  void set_advertisement_dedup_interval(uint32_t dedup_interval) {
+    this->advertisement_dedup_interval_ = dedup_interval;
+  }
   bool has_active() { return this->active_; }
 
   uint32_t get_legacy_version() const {
@@ -116,6 +126,12 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
 
  protected:
   void send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device);
+  void queue_advertisement_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result);
+  /// Encode the pending raw advertisements straight into one API frame and send it.
+  void flush_advertisements_();
+  void clear_pending_advertisements_();
+  /// Whether this advertisement was sent within the dedup interval, otherwise remember it as sent now.
+  bool is_recent_advertisement_(uint64_t key, uint32_t now);
 
   BluetoothConnection *get_connection_(uint64_t address, bool reserve);
 
@@ -124,6 +140,24 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   std::vector<BluetoothConnection *> connections_{};
   api::APIConnection *api_connection_{nullptr};
   bool raw_advertisements_{false};
+
+  /// Raw advertisements waiting to be sent. They point into the scan results of the tracker while those are handed to
+  /// parse_devices(), and into held_advertisements_ when a batch window keeps them longer.
+  std::vector<const esp_ble_gap_cb_param_t::ble_scan_result_evt_param *> pending_advertisements_{};
+  std::vector<esp_ble_gap_cb_param_t::ble_scan_result_evt_param> held_advertisements_{};
+  struct RecentAdvertisement {
+    uint64_t key;
+    uint32_t sent;
+  };
+  /// Advertisements sent recently, by a hash of address and payload, replaced in the order they were remembered.
+  /// Only allocated when the dedup interval is set.
+  std::vector<RecentAdvertisement> recent_advertisements_{};
+  uint8_t recent_advertisement_next_{0};
+  uint8_t advertisement_batch_size_{16};
+  uint32_t advertisement_batch_window_{0};
+  uint32_t advertisement_dedup_interval_{0};
+  /// When the oldest pending advertisement was queued.
+  uint32_t advertisement_batch_start_{0};
 };
 
 extern BluetoothProxy *global_bluetooth_proxy;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
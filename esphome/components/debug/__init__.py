@@ -13,6 +13,7 @@ CODEOWNERS = ["@OttoWinter"]
 DEPENDENCIES = ["logger"]
 
 CONF_DEBUG_ID = "debug_id"
+CONF_RUNTIME_STATS = "runtime_stats"
 debug_ns = cg.esphome_ns.namespace("debug")
 DebugComponent = debug_ns.class_("DebugComponent", cg.PollingComponent)
 
@@ -21,6 +22,7 @@ CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(DebugComponent),
+            cv.Optional(CONF_RUNTIME_STATS, default=False): cv.boolean,
             cv.Optional(CONF_DEVICE): cv.invalid(
                 "The 'device' option has been moved to the 'debug' text_sensor component"
             ),
@@ -44,3 +46,5 @@ CONFIG_SCHEMA = cv.All(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+    if config[CONF_RUNTIME_STATS]:
+        cg.add_define("USE_RUNTIME_STATS")
@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -28,7 +29,17 @@ void DebugComponent::dump_config() {
 #if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
 #endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
+#ifdef USE_RUNTIME_STATS
+  LOG_SENSOR("  ", "Loop load", this->loop_load_sensor_);
+#endif  // USE_RUNTIME_STATS
+#ifdef USE_API
+  LOG_SENSOR("  ", "API dropped messages", this->api_dropped_messages_sensor_);
+  LOG_SENSOR("  ", "API coalesced messages", this->api_coalesced_messages_sensor_);
+#endif  // USE_API
 #endif  // USE_SENSOR
+#if defined(USE_TEXT_SENSOR) && defined(USE_RUNTIME_STATS)
+  LOG_TEXT_SENSOR("  ", "Slowest component", this->slowest_component_);
+#endif
 
   std::string device_info;
   device_info.reserve(256);
@@ -83,10 +94,71 @@ void DebugComponent::update() {
     this->max_loop_time_ = 0;
   }
 
+#ifdef USE_API
+  if (this->api_dropped_messages_sensor_ != nullptr) {
+    this->api_dropped_messages_sensor_->publish_state(api::global_api_server->get_dropped_messages());
+  }
+  if (this->api_coalesced_messages_sensor_ != nullptr) {
+    this->api_coalesced_messages_sensor_->publish_state(api::global_api_server->get_coalesced_messages());
+  }
+#endif  // USE_API
 #endif  // USE_SENSOR
+#ifdef USE_RUNTIME_STATS
+  this->update_runtime_stats_();
+#endif
   update_platform_();
 }
 
+#ifdef USE_RUNTIME_STATS
+void DebugComponent::update_runtime_stats_() {
+  static const size_t TOP_COMPONENTS = 5;
+
+  const uint32_t now = micros();
+  const uint32_t elapsed_us = now - this->last_stats_time_us_;
+  const uint64_t idle_time_us = App.get_idle_time_us();
+  const uint64_t idle_us = idle_time_us - this->last_idle_time_us_;
+  this->last_stats_time_us_ = now;
+  this->last_idle_time_us_ = idle_time_us;
+  if (elapsed_us == 0)
+    return;
+
+  const auto &components = App.get_components();
+  this->last_component_time_us_.resize(components.size(), 0);
+  std::vector<std::pair<uint64_t, size_t>> deltas;
+  deltas.reserve(components.size());
+  for (size_t i = 0; i < components.size(); i++) {
+    const uint64_t total_us = components[i]->get_runtime_stats().total_time_us();
+    deltas.emplace_back(total_us - this->last_component_time_us_[i], i);
+    this->last_component_time_us_[i] = total_us;
+  }
+  const size_t top = std::min(TOP_COMPONENTS, deltas.size());
+  std::partial_sort(deltas.begin(), deltas.begin() + top, deltas.end(),
+                    [](const std::pair<uint64_t, size_t> &a, const std::pair<uint64_t, size_t> &b) {
+                      return a.first > b.first;
+                    });
+
+  const float load = 100.0f * (1.0f - std::min(1.0f, float(idle_us) / float(elapsed_us)));
+#ifdef ESPHOME_LOG_HAS_DEBUG
+  ESP_LOGD(TAG, "Loop load %.1f%% over the last %" PRIu32 " ms, top components:", load, elapsed_us / 1000);
+  for (size_t i = 0; i < top; i++) {
+    const Component *component = components[deltas[i].second];
+    const auto &stats = component->get_runtime_stats();
+    ESP_LOGD(TAG, "  %s: %.1f ms (loop max %" PRIu32 " us, scheduler max %" PRIu32 " us)",
+             component->get_component_source(), deltas[i].first / 1000.0f, stats.loop_max_us, stats.scheduler_max_us);
+  }
+#endif
+
+#ifdef USE_SENSOR
+  if (this->loop_load_sensor_ != nullptr)
+    this->loop_load_sensor_->publish_state(load);
+#endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+  if (this->slowest_component_ != nullptr && top > 0)
+    this->slowest_component_->publish_state(components[deltas[0].second]->get_component_source());
+#endif  // USE_TEXT_SENSOR
+}
+#endif  // USE_RUNTIME_STATS
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
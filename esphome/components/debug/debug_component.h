@@ -11,6 +11,9 @@
 #ifdef USE_TEXT_SENSOR
 #include "esphome/components/text_sensor/text_sensor.h"
 #endif
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
 
 namespace esphome {
 namespace debug {
@@ -25,6 +28,11 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   void set_device_info_sensor(text_sensor::TextSensor *device_info) { device_info_ = device_info; }
   void set_reset_reason_sensor(text_sensor::TextSensor *reset_reason) { reset_reason_ = reset_reason; }
+#ifdef USE_RUNTIME_STATS
+  void set_slowest_component_sensor(text_sensor::TextSensor *slowest_component) {
+    slowest_component_ = slowest_component;
+  }
+#endif  // USE_RUNTIME_STATS
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   void set_free_sensor(sensor::Sensor *free_sensor) { free_sensor_ = free_sensor; }
@@ -33,6 +41,17 @@ class DebugComponent : public PollingComponent {
   void set_fragmentation_sensor(sensor::Sensor *fragmentation_sensor) { fragmentation_sensor_ = fragmentation_sensor; }
 #endif
   void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { loop_time_sensor_ = loop_time_sensor; }
+#ifdef USE_RUNTIME_STATS
+  void set_loop_load_sensor(sensor::Sensor *loop_load_sensor) { loop_load_sensor_ = loop_load_sensor; }
+#endif  // USE_RUNTIME_STATS
+#ifdef USE_API
+  void set_api_dropped_messages_sensor(sensor::Sensor *api_dropped_messages_sensor) {
+    this->api_dropped_messages_sensor_ = api_dropped_messages_sensor;
+  }
+  void set_api_coalesced_messages_sensor(sensor::Sensor *api_coalesced_messages_sensor) {
+    this->api_coalesced_messages_sensor_ = api_coalesced_messages_sensor;
+  }
+#endif  // USE_API
 #ifdef USE_ESP32
   void set_psram_sensor(sensor::Sensor *psram_sensor) { this->psram_sensor_ = psram_sensor; }
 #endif  // USE_ESP32
@@ -50,6 +69,13 @@ class DebugComponent : public PollingComponent {
   sensor::Sensor *fragmentation_sensor_{nullptr};
 #endif
   sensor::Sensor *loop_time_sensor_{nullptr};
+#ifdef USE_RUNTIME_STATS
+  sensor::Sensor *loop_load_sensor_{nullptr};
+#endif  // USE_RUNTIME_STATS
+#ifdef USE_API
+  sensor::Sensor *api_dropped_messages_sensor_{nullptr};
+  sensor::Sensor *api_coalesced_messages_sensor_{nullptr};
+#endif  // USE_API
 #ifdef USE_ESP32
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
@@ -58,8 +84,21 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *device_info_{nullptr};
   text_sensor::TextSensor *reset_reason_{nullptr};
+#ifdef USE_RUNTIME_STATS
+  text_sensor::TextSensor *slowest_component_{nullptr};
+#endif  // USE_RUNTIME_STATS
 #endif  // USE_TEXT_SENSOR
 
+#ifdef USE_RUNTIME_STATS
+  /// Log the components that took the most time since the last update and publish the load sensors.
+  void update_runtime_stats_();
+
+  uint32_t last_stats_time_us_{0};
+  uint64_t last_idle_time_us_{0};
+  /// Total runtime of every component at the last update, indexed like App.get_components().
+  std::vector<uint64_t> last_component_time_us_;
+#endif  // USE_RUNTIME_STATS
+
   std::string get_reset_reason_();
   uint32_t get_free_heap_();
   void get_device_info_(std::string &device_info);
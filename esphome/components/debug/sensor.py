@@ -11,13 +11,18 @@ from esphome.const import (
     UNIT_PERCENT,
     UNIT_BYTES,
     ICON_COUNTER,
+    ICON_GAUGE,
     ICON_TIMER,
+    STATE_CLASS_TOTAL_INCREASING,
 )
 from . import CONF_DEBUG_ID, DebugComponent
 
 DEPENDENCIES = ["debug"]
 
 CONF_PSRAM = "psram"
+CONF_LOOP_LOAD = "loop_load"
+CONF_API_DROPPED_MESSAGES = "api_dropped_messages"
+CONF_API_COALESCED_MESSAGES = "api_coalesced_messages"
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -49,6 +54,30 @@ CONFIG_SCHEMA = {
         accuracy_decimals=0,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    cv.Optional(CONF_LOOP_LOAD): sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        icon=ICON_GAUGE,
+        accuracy_decimals=1,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_API_DROPPED_MESSAGES): cv.All(
+        cv.requires_component("api"),
+        sensor.sensor_schema(
+            icon=ICON_COUNTER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    ),
+    cv.Optional(CONF_API_COALESCED_MESSAGES): cv.All(
+        cv.requires_component("api"),
+        sensor.sensor_schema(
+            icon=ICON_COUNTER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    ),
     cv.Optional(CONF_PSRAM): cv.All(
         cv.only_on_esp32,
         cv.requires_component("psram"),
@@ -81,6 +110,19 @@ async def to_code(config):
         sens = await sensor.new_sensor(loop_time_conf)
         cg.add(debug_component.set_loop_time_sensor(sens))
 
+    if loop_load_conf := config.get(CONF_LOOP_LOAD):
+        sens = await sensor.new_sensor(loop_load_conf)
+        cg.add(debug_component.set_loop_load_sensor(sens))
+        cg.add_define("USE_RUNTIME_STATS")
+
+    if api_dropped_messages_conf := config.get(CONF_API_DROPPED_MESSAGES):
+        sens = await sensor.new_sensor(api_dropped_messages_conf)
+        cg.add(debug_component.set_api_dropped_messages_sensor(sens))
+
+    if api_coalesced_messages_conf := config.get(CONF_API_COALESCED_MESSAGES):
+        sens = await sensor.new_sensor(api_coalesced_messages_conf)
+        cg.add(debug_component.set_api_coalesced_messages_sensor(sens))
+
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
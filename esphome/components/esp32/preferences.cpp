@@ -1,6 +1,7 @@
 #ifdef USE_ESP32
 
 #include "esphome/core/preferences.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include <nvs_flash.h>
@@ -14,18 +15,67 @@ namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
+class ESP32PreferenceBackend;
+
 struct NVSData {
   std::string key;
   std::vector<uint8_t> data;
+  ESP32PreferenceBackend *backend;
 };
 
 static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_unchanged_saves = 0;       // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static uint32_t data_hash(const uint8_t *data, size_t len) {
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+static bool nvs_blob_equals(uint32_t nvs_handle, const std::string &key, const uint8_t *data, size_t len) {
+  size_t actual_len;
+  esp_err_t err = nvs_get_blob(nvs_handle, key.c_str(), nullptr, &actual_len);
+  if (err != 0) {
+    ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", key.c_str(), esp_err_to_name(err));
+    return false;
+  }
+  if (actual_len != len)
+    return false;
+  std::vector<uint8_t> stored(actual_len);
+  err = nvs_get_blob(nvs_handle, key.c_str(), stored.data(), &actual_len);
+  if (err != 0) {
+    ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", key.c_str(), esp_err_to_name(err));
+    return false;
+  }
+  return memcmp(stored.data(), data, len) == 0;
+}
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
   std::string key;
   uint32_t nvs_handle;
+  /// Hash of the data in NVS, once it is known from a load or a write. Data with a different hash has changed without
+  /// reading the blob back, so only pending saves that hash the same need to compare against NVS.
+  uint32_t stored_hash{0};
+  bool stored_hash_valid{false};
+
+  /// Whether NVS holds exactly this data. A matching hash is confirmed against the blob, a collision must not lose
+  /// a write.
+  bool is_stored(const uint8_t *data, size_t len) const {
+    if (!this->stored_hash_valid || data_hash(data, len) != this->stored_hash)
+      return false;
+    return nvs_blob_equals(this->nvs_handle, this->key, data, len);
+  }
+  void set_stored(const uint8_t *data, size_t len) {
+    this->stored_hash = data_hash(data, len);
+    this->stored_hash_valid = true;
+  }
+
   bool save(const uint8_t *data, size_t len) override {
+    // never read NVS here, write_pending_() drops unchanged data once a matching hash is confirmed against the blob
     // try find in pending saves and update that
     for (auto &obj : s_pending_save) {
       if (obj.key == key) {
@@ -36,6 +86,7 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
     NVSData save{};
     save.key = key;
     save.data.assign(data, data + len);
+    save.backend = this;
     s_pending_save.emplace_back(save);
     ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", key.c_str(), len);
     return true;
@@ -70,6 +121,7 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
     } else {
       ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key.c_str(), len);
     }
+    this->set_stored(data, len);
     return true;
   }
 };
@@ -108,9 +160,38 @@ class ESP32Preferences : public ESPPreferences {
   }
 
   bool sync() override {
+    bool done;
+    return this->write_pending_(UINT32_MAX, done);
+  }
+
+  bool sync_partial(uint32_t max_duration) override {
+    bool done;
+    this->write_pending_(max_duration, done);
+    return done;
+  }
+
+  bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
+    return !nvs_blob_equals(nvs_handle, to_save.key, to_save.data.data(), to_save.data.size());
+  }
+
+  bool reset() override {
+    ESP_LOGD(TAG, "Cleaning up preferences in flash...");
+    s_pending_save.clear();
+
+    nvs_flash_deinit();
+    nvs_flash_erase();
+    // Make the handle invalid to prevent any saves until restart
+    nvs_handle = 0;
+    return true;
+  }
+
+ protected:
+  bool write_pending_(uint32_t max_duration, bool &done) {
+    done = true;
     if (s_pending_save.empty())
       return true;
 
+    const uint32_t start = millis();
     ESP_LOGD(TAG, "Saving %d preferences to flash...", s_pending_save.size());
     // goal try write all pending saves even if one fails
     int cached = 0, written = 0, failed = 0;
@@ -119,9 +200,20 @@ class ESP32Preferences : public ESPPreferences {
 
     // go through vector from back to front (makes erase easier/more efficient)
     for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
+      if (cached + written + failed > 0 && millis() - start >= max_duration) {
+        // out of time, the rest is written on the next call
+        done = false;
+        break;
+      }
       const auto &save = s_pending_save[i];
       ESP_LOGVV(TAG, "Checking if NVS data %s has changed", save.key.c_str());
-      if (is_changed(nvs_handle, save)) {
+      bool changed;
+      if (save.backend->stored_hash_valid) {
+        changed = !save.backend->is_stored(save.data.data(), save.data.size());
+      } else {
+        changed = is_changed(nvs_handle, save);
+      }
+      if (changed) {
         esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
         ESP_LOGV(TAG, "sync: key: %s, len: %d", save.key.c_str(), save.data.size());
         if (err != 0) {
@@ -136,15 +228,22 @@ class ESP32Preferences : public ESPPreferences {
       } else {
         ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.data.size());
         cached++;
+        s_unchanged_saves++;
       }
+      save.backend->set_stored(save.data.data(), save.data.size());
       s_pending_save.erase(s_pending_save.begin() + i);
     }
+    this->total_writes_ += written;
     ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed", cached + written + failed, cached,
              written, failed);
+    if (!done)
+      ESP_LOGD(TAG, "Out of time after %" PRIu32 "ms, %d preferences left", millis() - start,
+               s_pending_save.size() - failed);
     if (failed > 0) {
       ESP_LOGE(TAG, "Error saving %d preferences to flash. Last error=%s for key=%s", failed, esp_err_to_name(last_err),
                last_key.c_str());
     }
+    this->log_wear_stats_();
 
     // note: commit on esp-idf currently is a no-op, nvs_set_blob always writes
     esp_err_t err = nvs_commit(nvs_handle);
@@ -155,33 +254,17 @@ class ESP32Preferences : public ESPPreferences {
 
     return failed == 0;
   }
-  bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
-    NVSData stored_data{};
-    size_t actual_len;
-    esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
-    if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", to_save.key.c_str(), esp_err_to_name(err));
-      return true;
-    }
-    stored_data.data.resize(actual_len);
-    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data.data(), &actual_len);
-    if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", to_save.key.c_str(), esp_err_to_name(err));
-      return true;
-    }
-    return to_save.data != stored_data.data;
-  }
 
-  bool reset() override {
-    ESP_LOGD(TAG, "Cleaning up preferences in flash...");
-    s_pending_save.clear();
-
-    nvs_flash_deinit();
-    nvs_flash_erase();
-    // Make the handle invalid to prevent any saves until restart
-    nvs_handle = 0;
-    return true;
+  void log_wear_stats_() {
+    nvs_stats_t stats;
+    if (nvs_get_stats(nullptr, &stats) != ESP_OK)
+      return;
+    ESP_LOGD(TAG, "Since boot: %" PRIu32 " writes, %" PRIu32 " unchanged saves dropped. NVS: %u entries used, %u free",
+             this->total_writes_, s_unchanged_saves, stats.used_entries, stats.free_entries);
   }
+
+  /// Number of blobs written to NVS since boot.
+  uint32_t total_writes_{0};
 };
 
 void setup_preferences() {
@@ -40,13 +40,12 @@ class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, publi
     if (this->address_ && device.address_uint64() != this->address_) {
       return false;
     }
-    for (auto &service_data : device.get_service_datas()) {
-      if (service_data.uuid == this->uuid_) {
-        this->trigger(service_data.data);
-        return true;
-      }
-    }
-    return false;
+    uint8_t len;
+    const uint8_t *data = device.find_service_data(this->uuid_, &len);
+    if (data == nullptr)
+      return false;
+    this->trigger(adv_data_t(data, data + len));
+    return true;
   }
 
  protected:
@@ -66,13 +65,12 @@ class BLEManufacturerDataAdvertiseTrigger : public Trigger<const adv_data_t &>,
     if (this->address_ && device.address_uint64() != this->address_) {
       return false;
     }
-    for (auto &manufacturer_data : device.get_manufacturer_datas()) {
-      if (manufacturer_data.uuid == this->uuid_) {
-        this->trigger(manufacturer_data.data);
-        return true;
-      }
-    }
-    return false;
+    uint8_t len;
+    const uint8_t *data = device.find_manufacturer_data(this->uuid_, &len);
+    if (data == nullptr)
+      return false;
+    this->trigger(adv_data_t(data, data + len));
+    return true;
   }
 
  protected:
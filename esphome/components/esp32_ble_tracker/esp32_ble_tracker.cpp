@@ -15,6 +15,7 @@
 #include <freertos/FreeRTOSConfig.h>
 #include <freertos/task.h>
 #include <nvs_flash.h>
+#include <algorithm>
 #include <cinttypes>
 
 #ifdef USE_OTA
@@ -36,6 +37,52 @@ namespace esp32_ble_tracker {
 
 static const char *const TAG = "esp32_ble_tracker";
 
+/// Call f(record_type, record, record_length) for every record of the advertisement and scan response, until it
+/// returns false.
+template<typename F>
+static void for_each_ad_record(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param, F &&f) {
+  size_t offset = 0;
+  const uint8_t *payload = param.ble_adv;
+  uint8_t len = param.adv_data_len + param.scan_rsp_len;
+
+  while (offset + 2 < len) {
+    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
+    if (field_length == 0) {
+      continue;  // Possible zero padded advertisement data
+    }
+    if (offset + field_length > len) {
+      break;  // record cut short
+    }
+    const uint8_t record_type = payload[offset];
+    if (!f(record_type, &payload[offset + 1], static_cast<uint8_t>(field_length - 1)))
+      return;
+    offset += field_length;
+  }
+}
+
+/// Get the UUID at the start of a service data record, returns the length of the UUID or 0 if it is not one.
+static uint8_t service_data_uuid(uint8_t record_type, const uint8_t *record, uint8_t record_length, ESPBTUUID *uuid) {
+  switch (record_type) {
+    case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      if (record_length < 2)
+        return 0;
+      *uuid = ESPBTUUID::from_uint16(encode_uint16(record[1], record[0]));
+      return 2;
+    case ESP_BLE_AD_TYPE_32SERVICE_DATA:
+      if (record_length < 4)
+        return 0;
+      *uuid = ESPBTUUID::from_uint32(encode_uint32(record[3], record[2], record[1], record[0]));
+      return 4;
+    case ESP_BLE_AD_TYPE_128SERVICE_DATA:
+      if (record_length < 16)
+        return 0;
+      *uuid = ESPBTUUID::from_raw(record);
+      return 16;
+    default:
+      return 0;
+  }
+}
+
 ESP32BLETracker *global_esp32_ble_tracker = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 float ESP32BLETracker::get_setup_priority() const { return setup_priority::AFTER_BLUETOOTH; }
@@ -56,7 +103,6 @@ void ESP32BLETracker::setup() {
   }
 
   global_esp32_ble_tracker = this;
-  this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
   this->scanner_idle_ = true;
 
@@ -107,30 +153,38 @@ void ESP32BLETracker::loop() {
   bool promote_to_connecting = discovered && !searching && !connecting;
 
   if (!this->scanner_idle_) {
-    if (this->scan_result_index_ &&  // if it looks like we have a scan result we will take the lock
-        xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
-      uint32_t index = this->scan_result_index_;
-      if (index >= ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
-        ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
-      }
+    const uint32_t tail = this->scan_result_tail_.load(std::memory_order_relaxed);
+    const uint32_t head = this->scan_result_head_.load(std::memory_order_acquire);
+    if (head != tail) {
+      const uint32_t count = head - tail;
+      const uint32_t start = tail % ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE;
 
       if (this->raw_advertisements_) {
+        // the results may wrap around the end of the ring, hand them over as up to two runs
+        const uint32_t first = std::min<uint32_t>(count, ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE - start);
         for (auto *listener : this->listeners_) {
-          listener->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+          listener->parse_devices(this->scan_result_buffer_ + start, first);
+          if (count > first)
+            listener->parse_devices(this->scan_result_buffer_, count - first);
         }
         for (auto *client : this->clients_) {
-          client->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+          client->parse_devices(this->scan_result_buffer_ + start, first);
+          if (count > first)
+            client->parse_devices(this->scan_result_buffer_, count - first);
         }
       }
 
       if (this->parse_advertisements_) {
-        for (size_t i = 0; i < index; i++) {
+        const uint32_t now = millis();
+        if (this->listener_index_dirty_)
+          this->rebuild_listener_index_();
+        for (uint32_t i = 0; i < count; i++) {
           ESPBTDevice device;
-          device.parse_scan_rst(this->scan_result_buffer_[i]);
+          device.parse_scan_rst(this->scan_result_buffer_[(tail + i) % ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE]);
 
           bool found = false;
-          for (auto *listener : this->listeners_) {
-            if (listener->parse_device(device))
+          for (uint16_t j : this->match_listeners_(device)) {
+            if (this->listeners_[j]->parse_device(device))
               found = true;
           }
 
@@ -143,13 +197,23 @@ void ESP32BLETracker::loop() {
             }
           }
 
+          // after the listeners, so they get to see the previous sighting
+          SeenDevice &seen = this->seen_devices_.update(device.address_uint64(), device.get_rssi(), now);
+
           if (!found && !this->scan_continuous_) {
-            this->print_bt_device_info(device);
+            this->print_bt_device_info_(device, seen);
           }
         }
       }
-      this->scan_result_index_ = 0;
-      xSemaphoreGive(this->scan_result_lock_);
+      // only now the slots may be reused by gap_scan_result_()
+      this->scan_result_tail_.store(head, std::memory_order_release);
+    }
+
+    const uint32_t dropped = this->scan_results_dropped_.load(std::memory_order_relaxed);
+    if (dropped != this->scan_results_dropped_reported_) {
+      ESP_LOGW(TAG, "Too many BLE events to process, %" PRIu32 " dropped (%" PRIu32 " since boot)",
+               dropped - this->scan_results_dropped_reported_, dropped);
+      this->scan_results_dropped_reported_ = dropped;
     }
 
     /*
@@ -272,7 +336,7 @@ void ESP32BLETracker::start_scan_(bool first) {
     for (auto *listener : this->listeners_)
       listener->on_scan_end();
   }
-  this->already_discovered_.clear();
+  this->seen_devices_.reset_printed();
   this->scan_params_.scan_type = this->scan_active_ ? BLE_SCAN_TYPE_ACTIVE : BLE_SCAN_TYPE_PASSIVE;
   this->scan_params_.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
   this->scan_params_.scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL;
@@ -306,7 +370,7 @@ void ESP32BLETracker::end_of_scan_() {
 
   ESP_LOGD(TAG, "End of scan.");
   this->scanner_idle_ = true;
-  this->already_discovered_.clear();
+  this->seen_devices_.reset_printed();
   xSemaphoreGive(this->scan_end_lock_);
   this->cancel_timeout("scan");
 
@@ -324,6 +388,112 @@ void ESP32BLETracker::register_listener(ESPBTDeviceListener *listener) {
   listener->set_parent(this);
   this->listeners_.push_back(listener);
   this->recalculate_advertisement_parser_types();
+  this->invalidate_listener_filters();
+}
+
+void ESPBTDeviceListener::add_filter_address(uint64_t address) {
+  this->filter_addresses_.push_back(address);
+  if (this->parent_ != nullptr)
+    this->parent_->invalidate_listener_filters();
+}
+void ESPBTDeviceListener::add_filter_service_uuid(const ESPBTUUID &uuid) {
+  this->filter_service_uuids_.push_back(uuid);
+  if (this->parent_ != nullptr)
+    this->parent_->invalidate_listener_filters();
+}
+void ESPBTDeviceListener::add_filter_manufacturer_id(uint16_t company_id) {
+  this->filter_manufacturer_ids_.push_back(company_id);
+  if (this->parent_ != nullptr)
+    this->parent_->invalidate_listener_filters();
+}
+
+void ESP32BLETracker::rebuild_listener_index_() {
+  this->listener_index_dirty_ = false;
+  this->address_index_.clear();
+  this->manufacturer_index_.clear();
+  this->service_uuid_index_.clear();
+  this->unfiltered_listeners_.clear();
+  for (uint16_t i = 0; i < this->listeners_.size(); i++) {
+    auto *listener = this->listeners_[i];
+    if (!listener->has_filter())
+      this->unfiltered_listeners_.push_back(i);
+    for (auto address : listener->get_filter_addresses())
+      this->address_index_.emplace_back(address, i);
+    for (auto company_id : listener->get_filter_manufacturer_ids())
+      this->manufacturer_index_.emplace_back(company_id, i);
+    for (auto &uuid : listener->get_filter_service_uuids())
+      this->service_uuid_index_.emplace_back(uuid, i);
+  }
+  std::sort(this->address_index_.begin(), this->address_index_.end());
+  std::sort(this->manufacturer_index_.begin(), this->manufacturer_index_.end());
+}
+
+const std::vector<uint16_t> &ESP32BLETracker::match_listeners_(const ESPBTDevice &device) {
+  if (this->unfiltered_listeners_.size() == this->listeners_.size())
+    return this->unfiltered_listeners_;
+  this->matched_listeners_.clear();
+  this->match_listener_filters_(device);
+  if (this->matched_listeners_.empty())
+    return this->unfiltered_listeners_;
+  // a listener can match more than one filter, offer the device to each listener once
+  this->matched_listeners_.insert(this->matched_listeners_.end(), this->unfiltered_listeners_.begin(),
+                                  this->unfiltered_listeners_.end());
+  std::sort(this->matched_listeners_.begin(), this->matched_listeners_.end());
+  this->matched_listeners_.erase(std::unique(this->matched_listeners_.begin(), this->matched_listeners_.end()),
+                                 this->matched_listeners_.end());
+  return this->matched_listeners_;
+}
+
+void ESP32BLETracker::match_listener_filters_(const ESPBTDevice &device) {
+  const uint64_t address = device.address_uint64();
+  for (auto it = std::lower_bound(this->address_index_.begin(), this->address_index_.end(),
+                                  std::make_pair(address, uint16_t(0)));
+       it != this->address_index_.end() && it->first == address; ++it)
+    this->matched_listeners_.push_back(it->second);
+
+  if (this->manufacturer_index_.empty() && this->service_uuid_index_.empty())
+    return;
+  auto match_uuid = [this](const ESPBTUUID &uuid) {
+    for (auto &entry : this->service_uuid_index_) {
+      if (entry.first == uuid)
+        this->matched_listeners_.push_back(entry.second);
+    }
+  };
+  for_each_ad_record(device.get_scan_result(), [&](uint8_t record_type, const uint8_t *record, uint8_t record_length) {
+    ESPBTUUID uuid;
+    switch (record_type) {
+      case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE: {
+        if (record_length < 2)
+          break;
+        const uint16_t company_id = encode_uint16(record[1], record[0]);
+        for (auto it = std::lower_bound(this->manufacturer_index_.begin(), this->manufacturer_index_.end(),
+                                        std::make_pair(company_id, uint16_t(0)));
+             it != this->manufacturer_index_.end() && it->first == company_id; ++it)
+          this->matched_listeners_.push_back(it->second);
+        break;
+      }
+      case ESP_BLE_AD_TYPE_16SRV_CMPL:
+      case ESP_BLE_AD_TYPE_16SRV_PART:
+        for (uint8_t i = 0; i + 2 <= record_length && !this->service_uuid_index_.empty(); i += 2)
+          match_uuid(ESPBTUUID::from_uint16(encode_uint16(record[i + 1], record[i])));
+        break;
+      case ESP_BLE_AD_TYPE_32SRV_CMPL:
+      case ESP_BLE_AD_TYPE_32SRV_PART:
+        for (uint8_t i = 0; i + 4 <= record_length && !this->service_uuid_index_.empty(); i += 4)
+          match_uuid(ESPBTUUID::from_uint32(encode_uint32(record[i + 3], record[i + 2], record[i + 1], record[i])));
+        break;
+      case ESP_BLE_AD_TYPE_128SRV_CMPL:
+      case ESP_BLE_AD_TYPE_128SRV_PART:
+        if (record_length >= 16 && !this->service_uuid_index_.empty())
+          match_uuid(ESPBTUUID::from_raw(record));
+        break;
+      default:
+        if (!this->service_uuid_index_.empty() && service_data_uuid(record_type, record, record_length, &uuid) != 0)
+          match_uuid(uuid);
+        break;
+    }
+    return true;
+  });
 }
 
 void ESP32BLETracker::recalculate_advertisement_parser_types() {
@@ -391,12 +561,13 @@ void ESP32BLETracker::gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_
 
 void ESP32BLETracker::gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   if (param.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
-    if (xSemaphoreTake(this->scan_result_lock_, 0L)) {
-      if (this->scan_result_index_ < ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
-        this->scan_result_buffer_[this->scan_result_index_++] = param;
-      }
-      xSemaphoreGive(this->scan_result_lock_);
+    const uint32_t head = this->scan_result_head_.load(std::memory_order_relaxed);
+    if (head - this->scan_result_tail_.load(std::memory_order_acquire) >= ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
+      this->scan_results_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
     }
+    this->scan_result_buffer_[head % ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE] = param;
+    this->scan_result_head_.store(head + 1, std::memory_order_release);
   } else if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
     xSemaphoreGive(this->scan_end_lock_);
   }
@@ -425,9 +596,10 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
     this->address_[i] = param.bda[i];
   this->address_type_ = param.ble_addr_type;
   this->rssi_ = param.rssi;
-  this->parse_adv_(param);
+  this->parsed_ = false;
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+  this->parse_adv_();
   ESP_LOGVV(TAG, "Parse Result:");
   const char *address_type = "";
   switch (this->address_type_) {
@@ -483,10 +655,82 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "  Adv data: %s", format_hex_pretty(param.ble_adv, param.adv_data_len + param.scan_rsp_len).c_str());
 #endif
 }
-void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
+
+bool ESPBTDevice::has_service_uuid(const ESPBTUUID &uuid) const {
+  bool found = false;
+  for_each_ad_record(this->scan_result_, [&](uint8_t record_type, const uint8_t *record, uint8_t record_length) {
+    switch (record_type) {
+      case ESP_BLE_AD_TYPE_16SRV_CMPL:
+      case ESP_BLE_AD_TYPE_16SRV_PART:
+        for (uint8_t i = 0; i + 2 <= record_length && !found; i += 2)
+          found = ESPBTUUID::from_uint16(encode_uint16(record[i + 1], record[i])) == uuid;
+        break;
+      case ESP_BLE_AD_TYPE_32SRV_CMPL:
+      case ESP_BLE_AD_TYPE_32SRV_PART:
+        for (uint8_t i = 0; i + 4 <= record_length && !found; i += 4)
+          found = ESPBTUUID::from_uint32(encode_uint32(record[i + 3], record[i + 2], record[i + 1], record[i])) == uuid;
+        break;
+      case ESP_BLE_AD_TYPE_128SRV_CMPL:
+      case ESP_BLE_AD_TYPE_128SRV_PART:
+        if (record_length >= 16)
+          found = ESPBTUUID::from_raw(record) == uuid;
+        break;
+      default:
+        break;
+    }
+    return !found;
+  });
+  return found;
+}
+
+const uint8_t *ESPBTDevice::find_service_data(const ESPBTUUID &uuid, uint8_t *len) const {
+  const uint8_t *data = nullptr;
+  for_each_ad_record(this->scan_result_, [&](uint8_t record_type, const uint8_t *record, uint8_t record_length) {
+    ESPBTUUID record_uuid;
+    const uint8_t uuid_length = service_data_uuid(record_type, record, record_length, &record_uuid);
+    if (uuid_length == 0 || !(record_uuid == uuid))
+      return true;
+    data = record + uuid_length;
+    *len = record_length - uuid_length;
+    return false;
+  });
+  return data;
+}
+
+const uint8_t *ESPBTDevice::find_manufacturer_data(const ESPBTUUID &uuid, uint8_t *len) const {
+  const uint8_t *data = nullptr;
+  for_each_ad_record(this->scan_result_, [&](uint8_t record_type, const uint8_t *record, uint8_t record_length) {
+    if (record_type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE || record_length < 2 ||
+        !(ESPBTUUID::from_uint16(encode_uint16(record[1], record[0])) == uuid))
+      return true;
+    data = record + 2;
+    *len = record_length - 2;
+    return false;
+  });
+  return data;
+}
+
+optional<ESPBLEiBeacon> ESPBTDevice::get_ibeacon() const {
+  optional<ESPBLEiBeacon> ibeacon{};
+  for_each_ad_record(this->scan_result_, [&](uint8_t record_type, const uint8_t *record, uint8_t record_length) {
+    // Apple's company identifier followed by the 23 bytes of beacon data
+    if (record_type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE || record_length != 25 || record[0] != 0x4C ||
+        record[1] != 0x00)
+      return true;
+    ibeacon = ESPBLEiBeacon(record + 2);
+    return false;
+  });
+  return ibeacon;
+}
+
+void ESPBTDevice::parse_adv_() const {
+  if (this->parsed_)
+    return;
+  this->parsed_ = true;
+
   size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
+  const uint8_t *payload = this->scan_result_.ble_adv;
+  uint8_t len = this->scan_result_.adv_data_len + this->scan_result_.scan_rsp_len;
 
   while (offset + 2 < len) {
     const uint8_t field_length = payload[offset++];  // First byte is length of adv record
@@ -658,15 +902,95 @@ void ESP32BLETracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Scan Window: %.1f ms", this->scan_window_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Type: %s", this->scan_active_ ? "ACTIVE" : "PASSIVE");
   ESP_LOGCONFIG(TAG, "  Continuous Scanning: %s", this->scan_continuous_ ? "True" : "False");
+  ESP_LOGCONFIG(TAG, "  Dropped Scan Results: %" PRIu32, this->scan_results_dropped_.load(std::memory_order_relaxed));
 }
 
-void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  for (auto &disc : this->already_discovered_) {
-    if (disc == address)
-      return;
+const SeenDevice *SeenDeviceCache::find(uint64_t address) const {
+  for (size_t i = home_(address);; i = (i + 1) % CAPACITY) {
+    const SeenDevice &device = this->devices_[i];
+    if (!device.used)
+      return nullptr;
+    if (device.address == address)
+      return &device;
+  }
+}
+
+SeenDevice &SeenDeviceCache::update(uint64_t address, int8_t rssi, uint32_t now) {
+  size_t i = home_(address);
+  while (this->devices_[i].used && this->devices_[i].address != address)
+    i = (i + 1) % CAPACITY;
+  if (!this->devices_[i].used) {
+    if (this->size_ == MAX_SIZE) {
+      // evicting moves entries around, look for the free slot again
+      this->evict_();
+      return this->update(address, rssi, now);
+    }
+    const auto bits = printed_bits_(address);
+    const bool printed = (this->printed_evicted_[bits.first / 32] >> (bits.first % 32) & 1) &&
+                         (this->printed_evicted_[bits.second / 32] >> (bits.second % 32) & 1);
+    this->devices_[i] = SeenDevice{address, now, rssi, printed, true, false};
+    this->size_++;
   }
-  this->already_discovered_.push_back(address);
+  this->devices_[i].rssi = rssi;
+  this->devices_[i].last_seen = now;
+  this->devices_[i].referenced = true;
+  return this->devices_[i];
+}
+
+void SeenDeviceCache::reset_printed() {
+  for (auto &device : this->devices_)
+    device.printed = false;
+  this->printed_evicted_.fill(0);
+  this->printed_evicted_count_ = 0;
+}
+
+std::pair<size_t, size_t> SeenDeviceCache::printed_bits_(uint64_t address) {
+  const uint64_t hash = address * 0x9E3779B97F4A7C15ULL;
+  return {(hash >> 32) % 1024, (hash >> 42) % 1024};
+}
+
+void SeenDeviceCache::evict_() {
+  // second chance: a device seen since the last pass of the hand only loses its reference bit
+  while (!this->devices_[this->hand_].used || this->devices_[this->hand_].referenced) {
+    this->devices_[this->hand_].referenced = false;
+    this->hand_ = (this->hand_ + 1) % CAPACITY;
+  }
+  const SeenDevice &victim = this->devices_[this->hand_];
+  if (victim.printed) {
+    if (this->printed_evicted_count_ == PRINTED_EVICTED_MAX) {
+      this->printed_evicted_.fill(0);
+      this->printed_evicted_count_ = 0;
+    }
+    this->printed_evicted_count_++;
+    const auto bits = printed_bits_(victim.address);
+    this->printed_evicted_[bits.first / 32] |= 1UL << (bits.first % 32);
+    this->printed_evicted_[bits.second / 32] |= 1UL << (bits.second % 32);
+  }
+  this->erase_(this->hand_);
+}
+
+void SeenDeviceCache::erase_(size_t index) {
+  // shift the following entries of the probe sequence back, so lookups do not stop early at the free slot
+  for (size_t next = (index + 1) % CAPACITY; this->devices_[next].used; next = (next + 1) % CAPACITY) {
+    const size_t home = home_(this->devices_[next].address);
+    const bool stays = index <= next ? (index < home && home <= next) : (index < home || home <= next);
+    if (stays)
+      continue;
+    this->devices_[index] = this->devices_[next];
+    index = next;
+  }
+  this->devices_[index].used = false;
+  this->size_--;
+}
+
+void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
+  this->print_bt_device_info_(device, this->seen_devices_.update(device.address_uint64(), device.get_rssi(), millis()));
+}
+
+void ESP32BLETracker::print_bt_device_info_(const ESPBTDevice &device, SeenDevice &seen) {
+  if (seen.printed)
+    return;
+  seen.printed = true;
 
   ESP_LOGD(TAG, "Found device %s RSSI=%d", device.address_str().c_str(), device.get_rssi());
 
@@ -6,6 +6,7 @@
 #include "esphome/core/helpers.h"
 
 #include <array>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -60,6 +61,12 @@ class ESPBLEiBeacon {
   } PACKED beacon_data_;
 };
 
+/** A device seen in a scan result.
+ *
+ * The address and RSSI are available right away. The advertisement itself is only decoded into the name, UUIDs and
+ * data the first time one of them is requested, so listeners that filter on the address or use the lookups below never
+ * allocate anything for advertisements they are not interested in.
+ */
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -72,49 +79,123 @@ class ESPBTDevice {
 
   esp_ble_addr_type_t get_address_type() const { return this->address_type_; }
   int get_rssi() const { return rssi_; }
-  const std::string &get_name() const { return this->name_; }
+  const std::string &get_name() const {
+    this->parse_adv_();
+    return this->name_;
+  }
+
+  const std::vector<int8_t> &get_tx_powers() const {
+    this->parse_adv_();
+    return tx_powers_;
+  }
 
-  const std::vector<int8_t> &get_tx_powers() const { return tx_powers_; }
+  const optional<uint16_t> &get_appearance() const {
+    this->parse_adv_();
+    return appearance_;
+  }
+  const optional<uint8_t> &get_ad_flag() const {
+    this->parse_adv_();
+    return ad_flag_;
+  }
+  const std::vector<ESPBTUUID> &get_service_uuids() const {
+    this->parse_adv_();
+    return service_uuids_;
+  }
 
-  const optional<uint16_t> &get_appearance() const { return appearance_; }
-  const optional<uint8_t> &get_ad_flag() const { return ad_flag_; }
-  const std::vector<ESPBTUUID> &get_service_uuids() const { return service_uuids_; }
+  const std::vector<ServiceData> &get_manufacturer_datas() const {
+    this->parse_adv_();
+    return manufacturer_datas_;
+  }
 
-  const std::vector<ServiceData> &get_manufacturer_datas() const { return manufacturer_datas_; }
+  const std::vector<ServiceData> &get_service_datas() const {
+    this->parse_adv_();
+    return service_datas_;
+  }
 
-  const std::vector<ServiceData> &get_service_datas() const { return service_datas_; }
+  /// Whether the advertisement lists the service UUID, without decoding it.
+  bool has_service_uuid(const ESPBTUUID &uuid) const;
+  /// Find the data advertised for the service UUID without decoding the advertisement or copying the data. Returns a
+  /// pointer into the scan result and sets len, or returns nullptr if there is none.
+  const uint8_t *find_service_data(const ESPBTUUID &uuid, uint8_t *len) const;
+  /// Like find_service_data(), for the manufacturer specific data of a company identifier.
+  const uint8_t *find_manufacturer_data(const ESPBTUUID &uuid, uint8_t *len) const;
 
   const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &get_scan_result() const { return scan_result_; }
 
   bool resolve_irk(const uint8_t *irk) const;
 
-  optional<ESPBLEiBeacon> get_ibeacon() const {
-    for (auto &it : this->manufacturer_datas_) {
-      auto res = ESPBLEiBeacon::from_manufacturer_data(it);
-      if (res.has_value())
-        return *res;
-    }
-    return {};
-  }
+  optional<ESPBLEiBeacon> get_ibeacon() const;
 
  protected:
-  void parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  /// Decode the advertisement, if that was not done yet.
+  void parse_adv_() const;
 
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
-  std::vector<int8_t> tx_powers_{};
-  optional<uint16_t> appearance_{};
-  optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_{};
-  std::vector<ServiceData> manufacturer_datas_{};
-  std::vector<ServiceData> service_datas_{};
+  mutable bool parsed_{false};
+  mutable std::string name_{};
+  mutable std::vector<int8_t> tx_powers_{};
+  mutable optional<uint16_t> appearance_{};
+  mutable optional<uint8_t> ad_flag_{};
+  mutable std::vector<ESPBTUUID> service_uuids_{};
+  mutable std::vector<ServiceData> manufacturer_datas_{};
+  mutable std::vector<ServiceData> service_datas_{};
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_{};
 };
 
+/// The last advertisement seen from an address.
+struct SeenDevice {
+  uint64_t address;
+  uint32_t last_seen;
+  int8_t rssi;
+  /// Whether print_bt_device_info() already logged the device during this scan.
+  bool printed;
+  bool used;
+  /// Seen since the eviction hand last passed, which spares the device once.
+  bool referenced;
+};
+
+/** Bounded hash set of the addresses seen recently, with open addressing and linear probing.
+ *
+ * Lookups and updates take constant time no matter how many devices are around. Once MAX_SIZE devices are known, a
+ * CLOCK hand picks a device that was not seen since the hand last passed it to make room for a new one.
+ */
+class SeenDeviceCache {
+ public:
+  static const uint8_t CAPACITY_BITS = 7;
+  static const size_t CAPACITY = 1 << CAPACITY_BITS;
+  static const size_t MAX_SIZE = CAPACITY * 3 / 4;
+
+  /// Get the entry of an address, nullptr if it was not seen recently.
+  const SeenDevice *find(uint64_t address) const;
+  /// Record an advertisement from an address and return its entry.
+  SeenDevice &update(uint64_t address, int8_t rssi, uint32_t now);
+  /// Forget which devices were printed, so the next scan logs them again.
+  void reset_printed();
+  size_t size() const { return this->size_; }
+
+ protected:
+  static size_t home_(uint64_t address) {
+    return static_cast<size_t>((address * 0x9E3779B97F4A7C15ULL) >> (64 - CAPACITY_BITS));
+  }
+  void evict_();
+  void erase_(size_t index);
+  /// Bits of an address in printed_evicted_.
+  static std::pair<size_t, size_t> printed_bits_(uint64_t address);
+
+  std::array<SeenDevice, CAPACITY> devices_{};
+  /// Devices that were printed during this scan and evicted since, so they are not logged again when they come back.
+  /// A false positive keeps a device out of the log, so it is cleared after PRINTED_EVICTED_MAX devices to stay sparse.
+  std::array<uint32_t, 32> printed_evicted_{};
+  static const uint8_t PRINTED_EVICTED_MAX = 128;
+  uint8_t printed_evicted_count_{0};
+  size_t size_{0};
+  size_t hand_{0};
+};
+
 class ESP32BLETracker;
 
 class ESPBTDeviceListener {
@@ -129,8 +210,28 @@ class ESPBTDeviceListener {
   };
   void set_parent(ESP32BLETracker *parent) { parent_ = parent; }
 
+  /** Only offer advertisements to parse_device() that come from one of the filter addresses, list or carry data for one
+   * of the filter service UUIDs, or carry manufacturer data of one of the filter company identifiers.
+   *
+   * The tracker indexes the filters, so advertisements are not handed to listeners that would reject them anyway.
+   * Listeners without any filter see every advertisement.
+   */
+  void add_filter_address(uint64_t address);
+  void add_filter_service_uuid(const ESPBTUUID &uuid);
+  void add_filter_manufacturer_id(uint16_t company_id);
+  bool has_filter() const {
+    return !this->filter_addresses_.empty() || !this->filter_service_uuids_.empty() ||
+           !this->filter_manufacturer_ids_.empty();
+  }
+  const std::vector<uint64_t> &get_filter_addresses() const { return this->filter_addresses_; }
+  const std::vector<ESPBTUUID> &get_filter_service_uuids() const { return this->filter_service_uuids_; }
+  const std::vector<uint16_t> &get_filter_manufacturer_ids() const { return this->filter_manufacturer_ids_; }
+
  protected:
   ESP32BLETracker *parent_{nullptr};
+  std::vector<uint64_t> filter_addresses_;
+  std::vector<ESPBTUUID> filter_service_uuids_;
+  std::vector<uint16_t> filter_manufacturer_ids_;
 };
 
 enum class ClientState {
@@ -203,8 +304,13 @@ class ESP32BLETracker : public Component,
   void register_listener(ESPBTDeviceListener *listener);
   void register_client(ESPBTClient *client);
   void recalculate_advertisement_parser_types();
+  /// Rebuild the index of the listener filters before the next advertisement is dispatched.
+  void invalidate_listener_filters() { this->listener_index_dirty_ = true; }
 
   void print_bt_device_info(const ESPBTDevice &device);
+  /// Get the sighting of an address before the advertisement being parsed right now, nullptr if it was not seen
+  /// recently. Lets listeners skip work for devices they just handled.
+  const SeenDevice *get_seen_device(uint64_t address) const { return this->seen_devices_.find(address); }
 
   void start_scan();
   void stop_scan();
@@ -220,6 +326,14 @@ class ESP32BLETracker : public Component,
   void start_scan_(bool first);
   /// Called when a scan ends
   void end_of_scan_();
+  /// Index the filters of all listeners.
+  void rebuild_listener_index_();
+  /// Get the indices of the listeners that want the device, in registration order.
+  const std::vector<uint16_t> &match_listeners_(const ESPBTDevice &device);
+  /// Add the indices of the listeners with a filter that matches the device to matched_listeners_.
+  void match_listener_filters_(const ESPBTDevice &device);
+  /// Log the device unless it was logged during this scan already, with its entry in seen_devices_.
+  void print_bt_device_info_(const ESPBTDevice &device, SeenDevice &seen);
   /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event is received.
   void gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT` event is received.
@@ -231,9 +345,19 @@ class ESP32BLETracker : public Component,
 
   int app_id_;
 
-  /// Vector of addresses that have already been printed in print_bt_device_info
-  std::vector<uint64_t> already_discovered_;
+  /// Addresses seen recently, also tracks which ones were printed in print_bt_device_info
+  SeenDeviceCache seen_devices_;
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// Listener filters, as (address, listener index) and (company identifier, listener index) sorted for binary search
+  /// and (service UUID, listener index) for the few UUIDs listeners filter on.
+  std::vector<std::pair<uint64_t, uint16_t>> address_index_;
+  std::vector<std::pair<uint16_t, uint16_t>> manufacturer_index_;
+  std::vector<std::pair<ESPBTUUID, uint16_t>> service_uuid_index_;
+  /// Indices of the listeners without a filter, which see every advertisement.
+  std::vector<uint16_t> unfiltered_listeners_;
+  /// Indices of the listeners the advertisement being dispatched should be offered to.
+  std::vector<uint16_t> matched_listeners_;
+  bool listener_index_dirty_{true};
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
   /// A structure holding the ESP BLE scan parameters.
@@ -249,15 +373,21 @@ class ESP32BLETracker : public Component,
   bool ble_was_disabled_{true};
   bool raw_advertisements_{false};
   bool parse_advertisements_{false};
-  SemaphoreHandle_t scan_result_lock_;
   SemaphoreHandle_t scan_end_lock_;
-  size_t scan_result_index_{0};
 #ifdef USE_PSRAM
   const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 32;
 #else
   const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 16;
 #endif  // USE_PSRAM
+  /// Single producer, single consumer ring of scan results. gap_scan_result_() only moves the head and loop() only
+  /// moves the tail, so neither side ever waits for the other. Both count up freely, the slot is the count modulo
+  /// SCAN_RESULT_BUFFER_SIZE.
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param *scan_result_buffer_;
+  std::atomic<uint32_t> scan_result_head_{0};
+  std::atomic<uint32_t> scan_result_tail_{0};
+  /// Scan results that arrived while the ring was full.
+  std::atomic<uint32_t> scan_results_dropped_{0};
+  uint32_t scan_results_dropped_reported_{0};
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
 };
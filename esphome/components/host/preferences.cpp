@@ -1,9 +1,17 @@
 #ifdef USE_HOST
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <vector>
 #include "preferences.h"
 #include "esphome/core/application.h"
+#include "esphome/core/log.h"
 
 namespace esphome {
 namespace host {
@@ -11,9 +19,15 @@ namespace fs = std::filesystem;
 
 static const char *const TAG = "host.preferences";
 
+static const size_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t);
+static const size_t MIN_CAPACITY = 4096;
+/// Superseded records are only squeezed out once they take up at least this many bytes.
+static const size_t COMPACT_THRESHOLD = 4096;
+
 void HostPreferences::setup_() {
   if (this->setup_complete_)
     return;
+  this->setup_complete_ = true;
   this->filename_.append(getenv("HOME"));
   this->filename_.append("/.esphome");
   this->filename_.append("/prefs");
@@ -21,43 +35,132 @@ void HostPreferences::setup_() {
   this->filename_.append("/");
   this->filename_.append(App.get_name());
   this->filename_.append(".prefs");
-  FILE *fp = fopen(this->filename_.c_str(), "rb");
-  if (fp != nullptr) {
-    while (!feof((fp))) {
-      uint32_t key;
-      uint8_t len;
-      if (fread(&key, sizeof(key), 1, fp) != 1)
-        break;
-      if (fread(&len, sizeof(len), 1, fp) != 1)
-        break;
-      uint8_t data[len];
-      if (fread(data, sizeof(uint8_t), len, fp) != len)
-        break;
-      std::vector vec(data, data + len);
-      this->data[key] = vec;
-    }
-    fclose(fp);
+
+  this->fd_ = open(this->filename_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (this->fd_ < 0) {
+    ESP_LOGE(TAG, "Could not open %s: %s", this->filename_.c_str(), strerror(errno));
+    return;
   }
-  this->setup_complete_ = true;
+  struct stat st {};
+  if (fstat(this->fd_, &st) != 0 || !this->map_file_(std::max<size_t>(st.st_size, MIN_CAPACITY)))
+    return;
+
+  size_t pos = 0;
+  while (pos + RECORD_HEADER_SIZE <= this->capacity_) {
+    uint32_t key;
+    memcpy(&key, this->data_ + pos, sizeof(key));
+    const uint8_t len = this->data_[pos + sizeof(key)];
+    // a zero length marks the end of the records, a record that does not fit was cut short
+    if (len == 0 || pos + RECORD_HEADER_SIZE + len > this->capacity_)
+      break;
+    auto it = this->records_.find(key);
+    if (it != this->records_.end())
+      this->stale_ += RECORD_HEADER_SIZE + it->second.len;
+    this->records_[key] = Record{pos + RECORD_HEADER_SIZE, len};
+    pos += RECORD_HEADER_SIZE + len;
+  }
+  this->used_ = pos;
+  memset(this->data_ + this->used_, 0, this->capacity_ - this->used_);
 }
 
-bool HostPreferences::sync() {
+bool HostPreferences::map_file_(size_t capacity) {
+  if (this->data_ != nullptr) {
+    munmap(this->data_, this->capacity_);
+    this->data_ = nullptr;
+  }
+  if (ftruncate(this->fd_, capacity) != 0) {
+    ESP_LOGE(TAG, "Could not resize %s: %s", this->filename_.c_str(), strerror(errno));
+    return false;
+  }
+  void *data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd_, 0);
+  if (data == MAP_FAILED) {
+    ESP_LOGE(TAG, "Could not map %s: %s", this->filename_.c_str(), strerror(errno));
+    return false;
+  }
+  this->data_ = static_cast<uint8_t *>(data);
+  this->capacity_ = capacity;
+  return true;
+}
+
+void HostPreferences::compact_() {
+  // move the current records down in file order, each one ends up at or before where it was
+  std::vector<std::pair<size_t, uint32_t>> order;
+  order.reserve(this->records_.size());
+  for (auto &it : this->records_)
+    order.emplace_back(it.second.offset, it.first);
+  std::sort(order.begin(), order.end());
+
+  size_t pos = 0;
+  for (auto &entry : order) {
+    Record &record = this->records_[entry.second];
+    const size_t size = RECORD_HEADER_SIZE + record.len;
+    memmove(this->data_ + pos, this->data_ + record.offset - RECORD_HEADER_SIZE, size);
+    record.offset = pos + RECORD_HEADER_SIZE;
+    pos += size;
+  }
+  memset(this->data_ + pos, 0, this->used_ - pos);
+  ESP_LOGV(TAG, "Compacted preferences from %zu to %zu bytes", this->used_, pos);
+  this->used_ = pos;
+  this->stale_ = 0;
+}
+
+bool HostPreferences::save(uint32_t key, const uint8_t *data, size_t len) {
+  if (len == 0 || len > 255)
+    return false;
   this->setup_();
-  FILE *fp = fopen(this->filename_.c_str(), "wb");
-  std::map<uint32_t, std::vector<uint8_t>>::iterator it;
-
-  for (it = this->data.begin(); it != this->data.end(); ++it) {
-    fwrite(&it->first, sizeof(uint32_t), 1, fp);
-    uint8_t len = it->second.size();
-    fwrite(&len, sizeof(len), 1, fp);
-    fwrite(it->second.data(), sizeof(uint8_t), it->second.size(), fp);
+  if (this->data_ == nullptr)
+    return false;
+
+  auto it = this->records_.find(key);
+  if (it != this->records_.end() && it->second.len == len) {
+    memcpy(this->data_ + it->second.offset, data, len);
+    return true;
   }
-  fclose(fp);
+
+  const size_t size = RECORD_HEADER_SIZE + len;
+  // keep at least one zeroed header after the last record to mark the end
+  const size_t needed = this->used_ + size + RECORD_HEADER_SIZE;
+  if (needed > this->capacity_ && !this->map_file_(std::max(this->capacity_ * 2, needed)))
+    return false;
+  if (it != this->records_.end())
+    this->stale_ += RECORD_HEADER_SIZE + it->second.len;
+
+  uint8_t *record = this->data_ + this->used_;
+  memcpy(record, &key, sizeof(key));
+  record[sizeof(key)] = len;
+  memcpy(record + RECORD_HEADER_SIZE, data, len);
+  this->records_[key] = Record{this->used_ + RECORD_HEADER_SIZE, static_cast<uint8_t>(len)};
+  this->used_ += size;
   return true;
 }
 
+bool HostPreferences::load(uint32_t key, uint8_t *data, size_t len) {
+  if (len > 255)
+    return false;
+  this->setup_();
+  auto it = this->records_.find(key);
+  if (this->data_ == nullptr || it == this->records_.end() || it->second.len != len)
+    return false;
+  memcpy(data, this->data_ + it->second.offset, len);
+  return true;
+}
+
+bool HostPreferences::sync() {
+  this->setup_();
+  if (this->data_ == nullptr)
+    return false;
+  if (this->stale_ >= COMPACT_THRESHOLD && this->stale_ * 2 >= this->used_)
+    this->compact_();
+  return msync(this->data_, this->capacity_, MS_SYNC) == 0;
+}
+
 bool HostPreferences::reset() {
-  host_preferences->data.clear();
+  this->setup_();
+  if (this->data_ != nullptr)
+    memset(this->data_, 0, this->used_);
+  this->records_.clear();
+  this->used_ = 0;
+  this->stale_ = 0;
   return true;
 }
 
@@ -3,7 +3,8 @@
 #ifdef USE_HOST
 
 #include "esphome/core/preferences.h"
-#include <map>
+#include <string>
+#include <unordered_map>
 
 namespace esphome {
 namespace host {
@@ -19,6 +20,12 @@ class HostPreferenceBackend : public ESPPreferenceBackend {
   uint32_t key_{};
 };
 
+/** Preferences stored in a memory mapped file under ~/.esphome/prefs.
+ *
+ * The file is a log of records (key, length, data). A save with the length of the key's current record overwrites that
+ * record in place, any other save appends a new record that supersedes the old one. Records that were superseded are
+ * squeezed out on sync() once they take up a good part of the file, so no save or sync rewrites the whole file.
+ */
 class HostPreferences : public ESPPreferences {
  public:
   bool sync() override;
@@ -29,33 +36,31 @@ class HostPreferences : public ESPPreferences {
     return make_preference(length, type, false);
   }
 
-  bool save(uint32_t key, const uint8_t *data, size_t len) {
-    if (len > 255)
-      return false;
-    this->setup_();
-    std::vector vec(data, data + len);
-    this->data[key] = vec;
-    return true;
-  }
-
-  bool load(uint32_t key, uint8_t *data, size_t len) {
-    if (len > 255)
-      return false;
-    this->setup_();
-    if (this->data.count(key) == 0)
-      return false;
-    auto vec = this->data[key];
-    if (vec.size() != len)
-      return false;
-    memcpy(data, vec.data(), len);
-    return true;
-  }
+  bool save(uint32_t key, const uint8_t *data, size_t len);
+  bool load(uint32_t key, uint8_t *data, size_t len);
 
  protected:
+  /// Where the data of the current record of a key is in the file.
+  struct Record {
+    size_t offset;
+    uint8_t len;
+  };
+
   void setup_();
+  bool map_file_(size_t capacity);
+  void compact_();
+
   bool setup_complete_{};
   std::string filename_{};
-  std::map<uint32_t, std::vector<uint8_t>> data{};
+  int fd_{-1};
+  uint8_t *data_{nullptr};
+  /// Size of the file and the mapping, the space after the last record is zeroed.
+  size_t capacity_{0};
+  /// Bytes taken up by records, including superseded ones.
+  size_t used_{0};
+  /// Bytes taken up by superseded records.
+  size_t stale_{0};
+  std::unordered_map<uint32_t, Record> records_{};
 };
 void setup_preferences();
 extern HostPreferences *host_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
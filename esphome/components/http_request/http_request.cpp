@@ -20,5 +20,34 @@ void HttpRequestComponent::dump_config() {
   }
 }
 
+bool HttpContainer::read_json(const json::json_value_t &f) {
+  json::JsonStreamParser parser(f);
+  uint8_t buf[128];
+  // the content length is -1 when the server did not send one, e.g. for a chunked response
+  const bool known_length = this->content_length != SIZE_MAX;
+  const uint32_t timeout = this->parent_->get_timeout();
+  uint32_t last_data = millis();
+  while (!known_length || this->get_bytes_read() < this->content_length) {
+    int read = this->read(buf, sizeof(buf));
+    if (read < 0)
+      break;
+    if (read > 0) {
+      last_data = millis();
+      if (!parser.feed(reinterpret_cast<const char *>(buf), read)) {
+        ESP_LOGW(TAG, "Response is not valid JSON");
+        return false;
+      }
+    } else if (this->is_read_complete() || (!known_length && parser.is_done())) {
+      break;
+    } else if (millis() - last_data > timeout) {
+      ESP_LOGW(TAG, "Timed out reading the response after %" PRIu32 " bytes", (uint32_t) this->get_bytes_read());
+      return false;
+    }
+    App.feed_wdt();
+    yield();
+  }
+  return parser.finish();
+}
+
 }  // namespace http_request
 }  // namespace esphome
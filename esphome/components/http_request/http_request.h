@@ -89,8 +89,20 @@ class HttpContainer : public Parented<HttpRequestComponent> {
   uint32_t duration_ms;
 
   virtual int read(uint8_t *buf, size_t max_len) = 0;
+  /// Whether the whole response body was received, so read() returning 0 means the end of the response.
+  virtual bool is_read_complete() = 0;
   virtual void end() = 0;
 
+  /** Read the rest of the response as JSON, chunk by chunk, and call f with every value in it.
+   *
+   * Unlike parsing the captured body, this does not need memory for the response, so it also works for responses
+   * larger than the free heap. Use it with `capture_response: false`. Without a Content-Length, reading stops at
+   * the end of the response or of the JSON document. It gives up when no data arrives for the request timeout.
+   *
+   * @return Whether the response was valid JSON.
+   */
+  bool read_json(const json::json_value_t &f);
+
   void set_secure(bool secure) { this->secure_ = secure; }
 
   size_t get_bytes_read() const { return this->bytes_read_; }
@@ -114,6 +126,7 @@ class HttpRequestComponent : public Component {
 
   void set_useragent(const char *useragent) { this->useragent_ = useragent; }
   void set_timeout(uint16_t timeout) { this->timeout_ = timeout; }
+  uint16_t get_timeout() const { return this->timeout_; }
   void set_watchdog_timeout(uint32_t watchdog_timeout) { this->watchdog_timeout_ = watchdog_timeout; }
   uint32_t get_watchdog_timeout() const { return this->watchdog_timeout_; }
   void set_follow_redirects(bool follow_redirects) { this->follow_redirects_ = follow_redirects; }
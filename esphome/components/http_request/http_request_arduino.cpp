@@ -154,6 +154,13 @@ int HttpContainerArduino::read(uint8_t *buf, size_t max_len) {
   return read_len;
 }
 
+bool HttpContainerArduino::is_read_complete() {
+  if (this->bytes_read_ >= this->content_length)
+    return true;
+  WiFiClient *stream_ptr = this->client_.getStreamPtr();
+  return stream_ptr == nullptr || (!stream_ptr->connected() && stream_ptr->available() == 0);
+}
+
 void HttpContainerArduino::end() {
   watchdog::WatchdogManager wdm(this->parent_->get_watchdog_timeout());
   this->client_.end();
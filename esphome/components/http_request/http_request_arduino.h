@@ -21,6 +21,7 @@ class HttpRequestArduino;
 class HttpContainerArduino : public HttpContainer {
  public:
   int read(uint8_t *buf, size_t max_len) override;
+  bool is_read_complete() override;
   void end() override;
 
  protected:
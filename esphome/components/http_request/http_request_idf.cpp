@@ -188,6 +188,8 @@ int HttpContainerIDF::read(uint8_t *buf, size_t max_len) {
   return read_len;
 }
 
+bool HttpContainerIDF::is_read_complete() { return esp_http_client_is_complete_data_received(this->client_); }
+
 void HttpContainerIDF::end() {
   watchdog::WatchdogManager wdm(this->parent_->get_watchdog_timeout());
 
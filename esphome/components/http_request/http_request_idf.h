@@ -16,6 +16,7 @@ class HttpContainerIDF : public HttpContainer {
  public:
   HttpContainerIDF(esp_http_client_handle_t client) : client_(client) {}
   int read(uint8_t *buf, size_t max_len) override;
+  bool is_read_complete() override;
   void end() override;
 
  protected:
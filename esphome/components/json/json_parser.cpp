@@ -0,0 +1,360 @@
+#include "json_parser.h"
+
+#include <cstring>
+#include <utility>
+
+namespace esphome {
+namespace json {
+
+static bool is_whitespace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+static int hex_value(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+static bool is_number(const char *c) {
+  if (*c == '-')
+    c++;
+  if (*c == '0') {
+    c++;
+  } else if (*c >= '1' && *c <= '9') {
+    while (is_digit(*c))
+      c++;
+  } else {
+    return false;
+  }
+  if (*c == '.') {
+    c++;
+    if (!is_digit(*c))
+      return false;
+    while (is_digit(*c))
+      c++;
+  }
+  if (*c == 'e' || *c == 'E') {
+    c++;
+    if (*c == '+' || *c == '-')
+      c++;
+    if (!is_digit(*c))
+      return false;
+    while (is_digit(*c))
+      c++;
+  }
+  return *c == '\0';
+}
+
+bool JsonStreamParser::feed(const char *data, size_t len) {
+  for (size_t i = 0; i < len && this->state_ != STATE_ERROR; i++) {
+    if (!this->parse_char_(data[i]))
+      this->state_ = STATE_ERROR;
+  }
+  return this->state_ != STATE_ERROR;
+}
+
+bool JsonStreamParser::finish() {
+  if (this->state_ == STATE_LITERAL && this->depth_ == 0 && !this->end_literal_())
+    this->state_ = STATE_ERROR;
+  return this->state_ == STATE_DONE;
+}
+
+void JsonStreamParser::reset() {
+  this->state_ = STATE_VALUE;
+  this->depth_ = 0;
+  this->overflow_level_ = 0;
+  this->arrays_ = 0;
+  this->high_surrogate_ = 0;
+  this->path_len_ = 0;
+  this->token_len_ = 0;
+}
+
+bool JsonStreamParser::parse_char_(char c) {
+  switch (this->state_) {
+    case STATE_STRING:
+      if (this->high_surrogate_ != 0 && c != '\\') {
+        this->append_code_point_(0xFFFD);
+        this->high_surrogate_ = 0;
+      }
+      if (c == '"') {
+        this->end_string_();
+      } else if (c == '\\') {
+        this->state_ = STATE_ESCAPE;
+      } else if (static_cast<uint8_t>(c) < 0x20) {
+        return false;
+      } else {
+        this->append_token_(c);
+      }
+      return true;
+    case STATE_ESCAPE:
+      if (this->high_surrogate_ != 0 && c != 'u') {
+        this->append_code_point_(0xFFFD);
+        this->high_surrogate_ = 0;
+      }
+      this->state_ = STATE_STRING;
+      switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+          this->append_token_(c);
+          return true;
+        case 'b':
+          this->append_token_('\b');
+          return true;
+        case 'f':
+          this->append_token_('\f');
+          return true;
+        case 'n':
+          this->append_token_('\n');
+          return true;
+        case 'r':
+          this->append_token_('\r');
+          return true;
+        case 't':
+          this->append_token_('\t');
+          return true;
+        case 'u':
+          this->state_ = STATE_UNICODE;
+          this->unicode_ = 0;
+          this->unicode_digits_ = 0;
+          return true;
+        default:
+          return false;
+      }
+    case STATE_UNICODE: {
+      const int value = hex_value(c);
+      if (value < 0)
+        return false;
+      this->unicode_ = (this->unicode_ << 4) | value;
+      if (++this->unicode_digits_ < 4)
+        return true;
+      this->state_ = STATE_STRING;
+      uint32_t code_point = this->unicode_;
+      if (code_point >= 0xD800 && code_point < 0xDC00) {
+        if (this->high_surrogate_ != 0)
+          this->append_code_point_(0xFFFD);
+        this->high_surrogate_ = code_point;
+        return true;
+      }
+      if (code_point >= 0xDC00 && code_point < 0xE000) {
+        code_point = this->high_surrogate_ == 0
+                         ? 0xFFFD
+                         : 0x10000 + ((this->high_surrogate_ - 0xD800) << 10) + (code_point - 0xDC00);
+      } else if (this->high_surrogate_ != 0) {
+        this->append_code_point_(0xFFFD);
+      }
+      this->high_surrogate_ = 0;
+      this->append_code_point_(code_point);
+      return true;
+    }
+    case STATE_LITERAL:
+      if ((c >= 'a' && c <= 'z') || is_digit(c) || c == '-' || c == '+' || c == '.' || c == 'E') {
+        this->append_token_(c);
+        return true;
+      }
+      if (!this->end_literal_())
+        return false;
+      // the character after the literal still has to be handled
+      return this->parse_char_(c);
+    default:
+      break;
+  }
+
+  if (is_whitespace(c))
+    return true;
+
+  switch (this->state_) {
+    case STATE_FIRST_VALUE:
+      if (c == ']') {
+        this->pop_();
+        return true;
+      }
+      return this->begin_value_(c);
+    case STATE_VALUE:
+      return this->begin_value_(c);
+    case STATE_FIRST_KEY:
+      if (c == '}') {
+        this->pop_();
+        return true;
+      }
+      // fall through
+    case STATE_KEY:
+      if (c != '"')
+        return false;
+      this->state_ = STATE_STRING;
+      this->in_key_ = true;
+      this->token_len_ = 0;
+      return true;
+    case STATE_COLON:
+      if (c != ':')
+        return false;
+      this->state_ = STATE_VALUE;
+      return true;
+    case STATE_AFTER_VALUE: {
+      const bool array = this->arrays_ & (1u << (this->depth_ - 1));
+      if (c == ',') {
+        if (array) {
+          this->index_[this->depth_ - 1]++;
+          this->state_ = STATE_VALUE;
+        } else {
+          this->state_ = STATE_KEY;
+        }
+        return true;
+      }
+      if (c != (array ? ']' : '}'))
+        return false;
+      this->pop_();
+      return true;
+    }
+    default:
+      // anything but whitespace after the end of the document
+      return false;
+  }
+}
+
+bool JsonStreamParser::begin_value_(char c) {
+  if (this->depth_ > 0 && (this->arrays_ & (1u << (this->depth_ - 1)))) {
+    char index[6];
+    size_t len = 0;
+    uint16_t value = this->index_[this->depth_ - 1];
+    do {
+      index[len++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    for (size_t i = 0; i < len / 2; i++)
+      std::swap(index[i], index[len - 1 - i]);
+    this->set_segment_(index, len);
+  }
+  if (c == '{')
+    return this->push_(false);
+  if (c == '[')
+    return this->push_(true);
+  this->token_len_ = 0;
+  if (c == '"') {
+    this->state_ = STATE_STRING;
+    this->in_key_ = false;
+    return true;
+  }
+  if (c == '-' || is_digit(c) || c == 't' || c == 'f' || c == 'n') {
+    this->state_ = STATE_LITERAL;
+    this->append_token_(c);
+    return true;
+  }
+  return false;
+}
+
+bool JsonStreamParser::push_(bool array) {
+  if (this->depth_ == MAX_DEPTH)
+    return false;
+  this->segment_start_[this->depth_] = this->path_len_;
+  this->index_[this->depth_] = 0;
+  if (array) {
+    this->arrays_ |= 1u << this->depth_;
+  } else {
+    this->arrays_ &= ~(1u << this->depth_);
+  }
+  this->depth_++;
+  this->state_ = array ? STATE_FIRST_VALUE : STATE_FIRST_KEY;
+  return true;
+}
+
+void JsonStreamParser::pop_() {
+  this->depth_--;
+  this->path_len_ = this->segment_start_[this->depth_];
+  if (this->overflow_level_ > this->depth_)
+    this->overflow_level_ = 0;
+  this->value_done_();
+}
+
+void JsonStreamParser::value_done_() { this->state_ = this->depth_ == 0 ? STATE_DONE : STATE_AFTER_VALUE; }
+
+void JsonStreamParser::end_string_() {
+  this->token_[this->token_len_] = '\0';
+  if (this->in_key_) {
+    this->set_segment_(this->token_, this->token_len_);
+    this->state_ = STATE_COLON;
+    return;
+  }
+  this->emit_(JSON_VALUE_STRING);
+  this->value_done_();
+}
+
+bool JsonStreamParser::end_literal_() {
+  this->token_[this->token_len_] = '\0';
+  JsonValueType type;
+  if (strcmp(this->token_, "true") == 0 || strcmp(this->token_, "false") == 0) {
+    type = JSON_VALUE_BOOL;
+  } else if (strcmp(this->token_, "null") == 0) {
+    type = JSON_VALUE_NULL;
+  } else if (this->token_len_ < MAX_VALUE_LENGTH - 1 && is_number(this->token_)) {
+    type = JSON_VALUE_NUMBER;
+  } else {
+    return false;
+  }
+  this->emit_(type);
+  this->value_done_();
+  return true;
+}
+
+void JsonStreamParser::set_segment_(const char *segment, size_t len) {
+  // a value below a segment that did not fit stays unreachable
+  if (this->overflow_level_ != 0 && this->overflow_level_ < this->depth_)
+    return;
+  this->overflow_level_ = 0;
+  size_t start = this->segment_start_[this->depth_ - 1];
+  const size_t separator = start > 0 ? 1 : 0;
+  if (start + separator + len >= MAX_PATH_LENGTH) {
+    this->overflow_level_ = this->depth_;
+    this->path_len_ = start;
+    return;
+  }
+  if (separator)
+    this->path_[start++] = '.';
+  memcpy(this->path_ + start, segment, len);
+  this->path_len_ = start + len;
+}
+
+void JsonStreamParser::emit_(JsonValueType type) {
+  if (this->overflow_level_ != 0)
+    return;
+  this->path_[this->path_len_] = '\0';
+  this->on_value_(this->path_, type, this->token_);
+}
+
+void JsonStreamParser::append_token_(char c) {
+  // leave room for the null terminator, longer values are truncated
+  if (this->token_len_ < MAX_VALUE_LENGTH - 1)
+    this->token_[this->token_len_++] = c;
+}
+
+void JsonStreamParser::append_code_point_(uint32_t code_point) {
+  if (code_point < 0x80) {
+    this->append_token_(code_point);
+  } else if (code_point < 0x800) {
+    this->append_token_(0xC0 | (code_point >> 6));
+    this->append_token_(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    this->append_token_(0xE0 | (code_point >> 12));
+    this->append_token_(0x80 | ((code_point >> 6) & 0x3F));
+    this->append_token_(0x80 | (code_point & 0x3F));
+  } else {
+    this->append_token_(0xF0 | (code_point >> 18));
+    this->append_token_(0x80 | ((code_point >> 12) & 0x3F));
+    this->append_token_(0x80 | ((code_point >> 6) & 0x3F));
+    this->append_token_(0x80 | (code_point & 0x3F));
+  }
+}
+
+bool parse_json_values(const std::string &data, const json_value_t &f) {
+  JsonStreamParser parser(f);
+  parser.feed(data.data(), data.size());
+  return parser.finish();
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace esphome {
+namespace json {
+
+enum JsonValueType : uint8_t {
+  JSON_VALUE_STRING,
+  JSON_VALUE_NUMBER,
+  JSON_VALUE_BOOL,
+  JSON_VALUE_NULL,
+};
+
+/** Callback function typedef for the values found by a JsonStreamParser.
+ *
+ * The path names the value by the keys and array indices leading to it, separated by dots (e.g. `data.items.0.name`).
+ * The value is the unescaped string, or the number, `true`, `false` or `null` as written in the document.
+ */
+using json_value_t = std::function<void(const char *path, JsonValueType type, const char *value)>;
+
+/** Parse a JSON document chunk by chunk and report every string, number, boolean and null in it.
+ *
+ * Nothing is built in memory, so parsing takes the same small fixed amount of memory no matter how large the document
+ * is. Callers pick out the values they need by their path. Strings longer than MAX_VALUE_LENGTH are truncated, values
+ * nested so deeply that their path does not fit into MAX_PATH_LENGTH are skipped.
+ */
+class JsonStreamParser {
+ public:
+  static const size_t MAX_PATH_LENGTH = 128;
+  static const size_t MAX_VALUE_LENGTH = 256;
+  static const uint8_t MAX_DEPTH = 32;
+
+  explicit JsonStreamParser(json_value_t on_value) : on_value_(std::move(on_value)) {}
+
+  /// Parse the next chunk of the document, returns false as soon as the document turns out to be invalid.
+  bool feed(const char *data, size_t len);
+  /// Finish parsing, returns whether a complete and valid document was parsed.
+  bool finish();
+  /// Start over with a new document.
+  void reset();
+
+  bool has_error() const { return this->state_ == STATE_ERROR; }
+  /// Whether the document is complete, only trailing whitespace may follow.
+  bool is_done() const { return this->state_ == STATE_DONE; }
+
+ protected:
+  enum State : uint8_t {
+    STATE_VALUE,
+    STATE_FIRST_VALUE,
+    STATE_FIRST_KEY,
+    STATE_KEY,
+    STATE_COLON,
+    STATE_AFTER_VALUE,
+    STATE_STRING,
+    STATE_ESCAPE,
+    STATE_UNICODE,
+    STATE_LITERAL,
+    STATE_DONE,
+    STATE_ERROR,
+  };
+
+  bool parse_char_(char c);
+  bool begin_value_(char c);
+  bool push_(bool array);
+  void pop_();
+  void value_done_();
+  void end_string_();
+  bool end_literal_();
+  void set_segment_(const char *segment, size_t len);
+  void emit_(JsonValueType type);
+  void append_token_(char c);
+  void append_code_point_(uint32_t code_point);
+
+  json_value_t on_value_;
+  State state_{STATE_VALUE};
+  bool in_key_{false};
+  uint8_t depth_{0};
+  /// Nesting level whose path segment did not fit, 0 if the path is complete.
+  uint8_t overflow_level_{0};
+  uint8_t unicode_digits_{0};
+  /// One bit per nesting level, set for arrays.
+  uint32_t arrays_{0};
+  uint16_t unicode_{0};
+  uint16_t high_surrogate_{0};
+  size_t path_len_{0};
+  size_t token_len_{0};
+  uint8_t segment_start_[MAX_DEPTH];
+  uint16_t index_[MAX_DEPTH];
+  char path_[MAX_PATH_LENGTH];
+  char token_[MAX_VALUE_LENGTH];
+};
+
+/// Parse a JSON string with a JsonStreamParser, returns whether it is valid.
+bool parse_json_values(const std::string &data, const json_value_t &f);
+
+}  // namespace json
+}  // namespace esphome
@@ -10,6 +10,9 @@
 
 #include <ArduinoJson.h>
 
+#include "json_parser.h"
+#include "json_writer.h"
+
 namespace esphome {
 namespace json {
 
@@ -0,0 +1,220 @@
+#include "json_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "esphome/core/string_ref.h"
+
+namespace esphome {
+namespace json {
+
+static const uint8_t MAX_DEPTH = 32;
+static const char *const HEX_CHARS = "0123456789abcdef";
+
+/// Format the value into the characters before end, returns where it starts. Not every platform's printf supports
+/// 64-bit integers.
+static char *format_unsigned(char *end, uint64_t value) {
+  do {
+    *--end = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  return end;
+}
+
+void JsonWriter::begin_object() {
+  this->separate_();
+  this->write_('{');
+  if (this->depth_ < MAX_DEPTH)
+    this->empty_ |= 1u << this->depth_;
+  this->depth_++;
+}
+void JsonWriter::end_object() {
+  if (this->depth_ > 0)
+    this->depth_--;
+  this->write_('}');
+}
+void JsonWriter::begin_array() {
+  this->separate_();
+  this->write_('[');
+  if (this->depth_ < MAX_DEPTH)
+    this->empty_ |= 1u << this->depth_;
+  this->depth_++;
+}
+void JsonWriter::end_array() {
+  if (this->depth_ > 0)
+    this->depth_--;
+  this->write_(']');
+}
+
+void JsonWriter::key(const char *key) {
+  this->write_string_(key, strlen(key));
+  this->write_(':');
+  this->after_key_ = true;
+}
+
+void JsonWriter::value(const char *value) {
+  if (value == nullptr) {
+    this->null_value();
+    return;
+  }
+  this->write_string_(value, strlen(value));
+}
+void JsonWriter::value(const StringRef &value) { this->write_string_(value.c_str(), value.size()); }
+void JsonWriter::value(bool value) {
+  this->separate_();
+  if (value) {
+    this->write_("true", 4);
+  } else {
+    this->write_("false", 5);
+  }
+}
+void JsonWriter::null_value() {
+  this->separate_();
+  this->write_("null", 4);
+}
+
+void JsonWriter::flush() {
+  if (!this->sink_ || this->pos_ == 0)
+    return;
+  this->sink_(this->buffer_, this->pos_);
+  this->total_ += this->pos_;
+  this->pos_ = 0;
+}
+
+void JsonWriter::separate_() {
+  if (this->after_key_) {
+    this->after_key_ = false;
+    return;
+  }
+  if (this->depth_ == 0 || this->depth_ > MAX_DEPTH)
+    return;
+  const uint32_t bit = 1u << (this->depth_ - 1);
+  if (this->empty_ & bit) {
+    this->empty_ &= ~bit;
+  } else {
+    this->write_(',');
+  }
+}
+
+void JsonWriter::write_(char c) {
+  if (this->pos_ == this->size_) {
+    if (!this->sink_) {
+      this->overflowed_ = true;
+      return;
+    }
+    this->flush();
+  }
+  this->buffer_[this->pos_++] = c;
+}
+void JsonWriter::write_(const char *data, size_t len) {
+  while (len > 0) {
+    if (this->pos_ == this->size_) {
+      if (!this->sink_) {
+        this->overflowed_ = true;
+        return;
+      }
+      this->flush();
+    }
+    const size_t chunk = std::min(len, this->size_ - this->pos_);
+    memcpy(this->buffer_ + this->pos_, data, chunk);
+    this->pos_ += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+void JsonWriter::write_string_(const char *value, size_t len) {
+  this->separate_();
+  this->write_('"');
+  const char *run = value;
+  for (const char *c = value; c < value + len; c++) {
+    const uint8_t ch = *c;
+    if (ch >= 0x20 && ch != '"' && ch != '\\')
+      continue;
+    this->write_(run, c - run);
+    run = c + 1;
+    this->write_('\\');
+    switch (ch) {
+      case '"':
+      case '\\':
+        this->write_(ch);
+        break;
+      case '\b':
+        this->write_('b');
+        break;
+      case '\f':
+        this->write_('f');
+        break;
+      case '\n':
+        this->write_('n');
+        break;
+      case '\r':
+        this->write_('r');
+        break;
+      case '\t':
+        this->write_('t');
+        break;
+      default:
+        this->write_("u00", 3);
+        this->write_(HEX_CHARS[ch >> 4]);
+        this->write_(HEX_CHARS[ch & 0x0F]);
+        break;
+    }
+  }
+  this->write_(run, value + len - run);
+  this->write_('"');
+}
+
+void JsonWriter::write_signed_(int64_t value) {
+  this->separate_();
+  char buf[21];
+  char *end = buf + sizeof(buf);
+  char *start = format_unsigned(end, value < 0 ? 0 - static_cast<uint64_t>(value) : value);
+  if (value < 0)
+    *--start = '-';
+  this->write_(start, end - start);
+}
+void JsonWriter::write_unsigned_(uint64_t value) {
+  this->separate_();
+  char buf[20];
+  char *end = buf + sizeof(buf);
+  char *start = format_unsigned(end, value);
+  this->write_(start, end - start);
+}
+void JsonWriter::write_float_(double value, int precision) {
+  if (std::isnan(value) || std::isinf(value)) {
+    this->null_value();
+    return;
+  }
+  this->separate_();
+  char buf[32];
+  const int len = snprintf(buf, sizeof(buf), "%.*g", precision, value);
+  this->write_(buf, len);
+}
+
+std::string write_json(const json_write_t &f) {
+  std::string output;
+  char buffer[128];
+  JsonWriter writer(buffer, sizeof(buffer), [&output](const char *data, size_t len) { output.append(data, len); });
+  f(writer);
+  writer.flush();
+  return output;
+}
+
+size_t write_json(char *buffer, size_t size, const json_write_t &f) {
+  if (size == 0)
+    return 0;
+  JsonWriter writer(buffer, size - 1);
+  f(writer);
+  if (writer.overflowed()) {
+    buffer[0] = '\0';
+    return 0;
+  }
+  buffer[writer.get_length()] = '\0';
+  return writer.get_length();
+}
+
+}  // namespace json
+}  // namespace esphome
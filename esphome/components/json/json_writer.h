@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+namespace esphome {
+
+class StringRef;
+
+namespace json {
+
+/// Callback function typedef for receiving the output of a JsonWriter.
+using json_sink_t = std::function<void(const char *data, size_t len)>;
+
+/** Write a JSON document in a single pass, without building it in memory first.
+ *
+ * The output goes into a caller provided buffer. Without a sink the document has to fit into the buffer, anything that
+ * does not is dropped and overflowed() is set. With a sink the buffer is handed to it whenever it fills up and on
+ * flush(), so a document of any size can be streamed to a string or a socket through a small buffer.
+ *
+ * Commas and the nesting of objects and arrays are tracked by the writer, for example:
+ *
+ * ```cpp
+ * writer.begin_object();
+ * writer.add("id", "sensor-temperature");
+ * writer.add("value", 21.5f);
+ * writer.begin_array("values");
+ * writer.value(1);
+ * writer.end_array();
+ * writer.end_object();
+ * ```
+ */
+class JsonWriter {
+ public:
+  JsonWriter(char *buffer, size_t size) : buffer_(buffer), size_(size) {}
+  JsonWriter(char *buffer, size_t size, json_sink_t sink) : buffer_(buffer), size_(size), sink_(std::move(sink)) {}
+
+  void begin_object();
+  void begin_object(const char *key) {
+    this->key(key);
+    this->begin_object();
+  }
+  void end_object();
+  void begin_array();
+  void begin_array(const char *key) {
+    this->key(key);
+    this->begin_array();
+  }
+  void end_array();
+
+  /// Write the key of the next member of the current object.
+  void key(const char *key);
+
+  /// Write a value, either as the next element of the current array or for the key written before.
+  void value(const char *value);
+  void value(const std::string &value) { this->write_string_(value.data(), value.size()); }
+  void value(const StringRef &value);
+  void value(bool value);
+  template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> void value(T value) {
+    if (std::is_signed<T>::value) {
+      this->write_signed_(static_cast<int64_t>(value));
+    } else {
+      this->write_unsigned_(static_cast<uint64_t>(value));
+    }
+  }
+  /// Write a number, NaN and infinity are written as null.
+  void value(float value) { this->write_float_(value, 7); }
+  void value(double value) { this->write_float_(value, 15); }
+  void null_value();
+
+  /// Write a member of the current object.
+  template<typename T> void add(const char *key, T &&value) {
+    this->key(key);
+    this->value(std::forward<T>(value));
+  }
+  void add_null(const char *key) {
+    this->key(key);
+    this->null_value();
+  }
+
+  /// Hand the buffered output to the sink, if there is one.
+  void flush();
+
+  /// Number of characters of the document written so far.
+  size_t get_length() const { return this->total_ + this->pos_; }
+  /// Whether part of the document was dropped because it did not fit into the buffer.
+  bool overflowed() const { return this->overflowed_; }
+
+ protected:
+  void separate_();
+  void write_(char c);
+  void write_(const char *data, size_t len);
+  void write_string_(const char *value, size_t len);
+  void write_signed_(int64_t value);
+  void write_unsigned_(uint64_t value);
+  void write_float_(double value, int precision);
+
+  char *buffer_;
+  size_t size_;
+  json_sink_t sink_;
+  size_t pos_{0};
+  size_t total_{0};
+  /// One bit per nesting level, set while the container at that level has no members yet.
+  uint32_t empty_{0};
+  uint8_t depth_{0};
+  bool after_key_{false};
+  bool overflowed_{false};
+};
+
+/// Callback function typedef for writing a JSON document with a JsonWriter.
+using json_write_t = std::function<void(JsonWriter &)>;
+
+/// Write a JSON document into a string in a single pass with the provided write function.
+std::string write_json(const json_write_t &f);
+
+/** Write a JSON document into the buffer in a single pass with the provided write function.
+ *
+ * The document is null terminated. Returns its length, or 0 if it did not fit into the buffer.
+ */
+size_t write_json(char *buffer, size_t size, const json_write_t &f);
+
+}  // namespace json
+}  // namespace esphome
@@ -24,7 +24,9 @@ from esphome.const import (
     CONF_HARDWARE_UART,
     CONF_ID,
     CONF_LEVEL,
+    CONF_LOG_TOPIC,
     CONF_LOGS,
+    CONF_MQTT,
     CONF_ON_MESSAGE,
     CONF_TAG,
     CONF_TRIGGER_ID,
@@ -36,6 +38,7 @@ from esphome.const import (
     PLATFORM_RTL87XX,
 )
 from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
+import esphome.final_validate as fv
 
 CODEOWNERS = ["@esphome/core"]
 logger_ns = cg.esphome_ns.namespace("logger")
@@ -153,6 +156,29 @@ def uart_selection(value):
     raise NotImplementedError
 
 
+def validate_deferred(value):
+    # on_message gets the records as sent, only the host decodes them
+    if value.get(CONF_DEFERRED) and CONF_ON_MESSAGE in value:
+        raise cv.Invalid(
+            f"{CONF_ON_MESSAGE} would receive unformatted records with '{CONF_DEFERRED}: true'",
+            path=[CONF_ON_MESSAGE],
+        )
+    return value
+
+
+def validate_async_buffer_size(value):
+    # the queue holds at least 4 messages of tx_buffer_size bytes plus the terminator
+    if CONF_ASYNC_BUFFER_SIZE in value:
+        minimum = 4 * (value[CONF_TX_BUFFER_SIZE] + 1)
+        if value[CONF_ASYNC_BUFFER_SIZE] < minimum:
+            raise cv.Invalid(
+                f"{CONF_ASYNC_BUFFER_SIZE} must hold at least 4 messages of {CONF_TX_BUFFER_SIZE}, "
+                f"{minimum} bytes",
+                path=[CONF_ASYNC_BUFFER_SIZE],
+            )
+    return value
+
+
 def validate_local_no_higher_than_global(value):
     global_level = value.get(CONF_LEVEL, "DEBUG")
     for tag, level in value.get(CONF_LOGS, {}).items():
@@ -164,16 +190,50 @@ def validate_local_no_higher_than_global(value):
 
 
 Logger = logger_ns.class_("Logger", cg.Component)
+TagLogLevel = logger_ns.struct("TagLogLevel")
 LoggerMessageTrigger = logger_ns.class_(
     "LoggerMessageTrigger",
     automation.Trigger.template(cg.int_, cg.const_char_ptr, cg.const_char_ptr),
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_DEFERRED = "deferred"
+CONF_ASYNC_BUFFER_SIZE = "async_buffer_size"
+CONF_TAG_LEVELS_ID = "tag_levels_id"
+
+
+def tag_hash(tag: str) -> int:
+    """FNV-1 hash of the UTF-8 bytes of a tag, the same as tag_hash() in logger.cpp."""
+    value = 2166136261
+    for char in tag.encode():
+        value = (value * 16777619) & 0xFFFFFFFF
+        value ^= char
+    return value
+
+
+def build_tag_level_table(levels: dict[str, int]) -> list[tuple[str, int] | None]:
+    """Place the tags in an open addressing table with linear probing.
+
+    The table size is a power of two with at least one free slot per tag, so a lookup on
+    the device takes about one probe and always ends at a free slot.
+    """
+    size = 1
+    while size < 2 * len(levels):
+        size *= 2
+    table: list[tuple[str, int] | None] = [None] * size
+    for tag, level in levels.items():
+        index = tag_hash(tag) & (size - 1)
+        while table[index] is not None:
+            index = (index + 1) & (size - 1)
+        table[index] = (tag, level)
+    return table
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(Logger),
+            cv.GenerateID(CONF_TAG_LEVELS_ID): cv.declare_id(TagLogLevel),
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
@@ -216,12 +276,46 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.Optional(CONF_DEFERRED): cv.All(
+                cv.boolean,
+                cv.only_on(
+                    [
+                        PLATFORM_ESP8266,
+                        PLATFORM_ESP32,
+                        PLATFORM_RP2040,
+                        PLATFORM_BK72XX,
+                        PLATFORM_RTL87XX,
+                    ]
+                ),
+            ),
+            cv.Optional(CONF_ASYNC_BUFFER_SIZE): cv.All(
+                cv.only_on_esp32, cv.validate_bytes, cv.int_range(min=1024)
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
+    validate_deferred,
+    validate_async_buffer_size,
 )
 
 
+def _final_validate(config):
+    if not config.get(CONF_DEFERRED):
+        return config
+    # MQTT would publish the records as sent. The native API sends them as is too: `esphome logs`
+    # decodes them, but the log view of Home Assistant shows the raw records.
+    mqtt_config = fv.full_config.get().get(CONF_MQTT, {})
+    if mqtt_config.get(CONF_LOG_TOPIC):
+        raise cv.Invalid(
+            f"MQTT log forwarding cannot decode the records of '{CONF_DEFERRED}: true', "
+            f"set '{CONF_LOG_TOPIC}: null' in the {CONF_MQTT} configuration"
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 @coroutine_with_priority(90.0)
 async def to_code(config):
     baud_rate = config[CONF_BAUD_RATE]
@@ -232,10 +326,29 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
+    if CONF_ASYNC_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_ASYNC")
+        cg.add(log.set_async_buffer_size(config[CONF_ASYNC_BUFFER_SIZE]))
     cg.add(log.pre_setup())
 
-    for tag, level in config[CONF_LOGS].items():
-        cg.add(log.set_log_level(tag, LOG_LEVELS[level]))
+    if config[CONF_LOGS]:
+        table = build_tag_level_table(config[CONF_LOGS])
+        initializer = []
+        for entry in table:
+            if entry is None:
+                initializer.append(cg.StructInitializer(TagLogLevel))
+                continue
+            tag, level = entry
+            initializer.append(
+                cg.StructInitializer(
+                    TagLogLevel,
+                    ("tag", tag),
+                    ("hash", tag_hash(tag)),
+                    ("level", LOG_LEVELS[level]),
+                )
+            )
+        tag_levels = cg.static_const_array(config[CONF_TAG_LEVELS_ID], initializer)
+        cg.add(log.set_tag_levels(tag_levels, len(table)))
 
     level = config[CONF_LEVEL]
     cg.add_define("USE_LOGGER")
@@ -278,6 +391,8 @@ async def to_code(config):
         cg.add_build_flag("-DENABLE_I2C_DEBUG_BUFFER")
     if config.get(CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH):
         cg.add_build_flag("-DUSE_STORE_LOG_STR_IN_FLASH")
+    if config.get(CONF_DEFERRED):
+        cg.add_define("USE_LOGGER_DEFERRED")
 
     if CORE.using_arduino:
         if config[CONF_HARDWARE_UART] == USB_CDC:
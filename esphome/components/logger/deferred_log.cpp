@@ -0,0 +1,188 @@
+#include "deferred_log.h"
+
+#ifdef USE_LOGGER_DEFERRED
+
+#include <cstdint>
+#include <cstring>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace logger {
+
+static const char *const BASE64_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+namespace {
+
+class RecordWriter {
+ public:
+  RecordWriter(uint8_t *at, uint8_t *end) : at_(at), end_(end) {}
+
+  template<typename T> void write(T value) {
+    if (this->full_ || static_cast<size_t>(this->end_ - this->at_) < sizeof(T)) {
+      this->full_ = true;
+      return;
+    }
+    memcpy(this->at_, &value, sizeof(T));
+    this->at_ += sizeof(T);
+  }
+  void write_string(const char *value, int precision) {
+    if (value == nullptr)
+      value = "(null)";
+    size_t len = precision < 0 ? strlen(value) : strnlen(value, precision);
+    size_t available = this->end_ - this->at_;
+    if (this->full_ || available == 0) {
+      this->full_ = true;
+      return;
+    }
+    if (len >= available) {
+      len = available - 1;
+      this->full_ = true;
+    }
+    memcpy(this->at_, value, len);
+    this->at_ += len;
+    *this->at_++ = '\0';
+  }
+  bool is_full() const { return this->full_; }
+  uint8_t *get_position() const { return this->at_; }
+
+ protected:
+  uint8_t *at_;
+  uint8_t *end_;
+  bool full_{false};
+};
+
+}  // namespace
+
+static void write_integer(RecordWriter &writer, const char *length, va_list *args) {
+  if (length[0] == 'l' && length[1] == 'l') {
+    writer.write(va_arg(*args, long long));
+  } else if (length[0] == 'l') {
+    writer.write(va_arg(*args, long));
+  } else if (length[0] == 'j') {
+    writer.write(va_arg(*args, intmax_t));
+  } else if (length[0] == 'z') {
+    writer.write(va_arg(*args, size_t));
+  } else if (length[0] == 't') {
+    writer.write(va_arg(*args, ptrdiff_t));
+  } else {
+    // char and short arguments are promoted to int
+    writer.write(va_arg(*args, int));
+  }
+}
+
+/// Encode the record, returns its end. Walks the format string the same way vsnprintf() consumes the arguments.
+static uint8_t *encode_record(uint8_t *buffer, uint8_t *end, int level, const char *tag, int line,
+                              const void *format_ptr, const char *format, va_list *args) {
+  RecordWriter writer(buffer, end);
+  writer.write<uint8_t>(level);
+  writer.write<uint16_t>(line);
+  writer.write<uint32_t>(reinterpret_cast<uintptr_t>(tag));
+  writer.write<uint32_t>(reinterpret_cast<uintptr_t>(format_ptr));
+
+  const char *c = format;
+  while (*c != '\0' && !writer.is_full()) {
+    if (*c++ != '%')
+      continue;
+    while (*c == '-' || *c == '+' || *c == ' ' || *c == '#' || *c == '0')
+      c++;
+    if (*c == '*') {
+      writer.write<int32_t>(va_arg(*args, int));
+      c++;
+    }
+    while (*c >= '0' && *c <= '9')
+      c++;
+    int precision = -1;
+    if (*c == '.') {
+      c++;
+      precision = 0;
+      if (*c == '*') {
+        precision = va_arg(*args, int);
+        writer.write<int32_t>(precision);
+        c++;
+      }
+      while (*c >= '0' && *c <= '9')
+        precision = precision * 10 + (*c++ - '0');
+    }
+    const char *length = c;
+    while (*c == 'h' || *c == 'l' || *c == 'j' || *c == 'z' || *c == 't' || *c == 'L')
+      c++;
+
+    switch (*c) {
+      case 'd':
+      case 'i':
+      case 'o':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'c':
+        write_integer(writer, length, args);
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        if (length[0] == 'L') {
+          writer.write(static_cast<double>(va_arg(*args, long double)));
+        } else {
+          writer.write(va_arg(*args, double));
+        }
+        break;
+      case 's':
+        writer.write_string(va_arg(*args, const char *), precision);
+        break;
+      case 'p':
+        writer.write<uint32_t>(reinterpret_cast<uintptr_t>(va_arg(*args, void *)));
+        break;
+      case 'n':
+        va_arg(*args, void *);
+        break;
+      case '\0':
+        return writer.get_position();
+      default:
+        break;
+    }
+    c++;
+  }
+  return writer.get_position();
+}
+
+size_t HOT write_deferred_log(char *out, size_t size, int level, const char *tag, int line, const void *format_ptr,
+                              const char *format, va_list args) {
+  const size_t prefix_len = strlen(DEFERRED_LOG_PREFIX);
+  if (size < prefix_len + 4)
+    return 0;
+  memcpy(out, DEFERRED_LOG_PREFIX, prefix_len);
+
+  // Encode the record into the back of the buffer and base64 encode it to the front. The output never overtakes the
+  // input, every three bytes read free up the room for the four characters written.
+  const size_t capacity = (size - prefix_len) / 4 * 3;
+  uint8_t *record = reinterpret_cast<uint8_t *>(out + size - capacity);
+  va_list args_copy;
+  va_copy(args_copy, args);
+  uint8_t *record_end = encode_record(record, record + capacity, level, tag, line, format_ptr, format, &args_copy);
+  va_end(args_copy);
+
+  char *at = out + prefix_len;
+  for (const uint8_t *in = record; in < record_end; in += 3) {
+    const size_t remaining = record_end - in;
+    const uint32_t b0 = in[0];
+    const uint32_t b1 = remaining > 1 ? in[1] : 0;
+    const uint32_t b2 = remaining > 2 ? in[2] : 0;
+    const uint32_t triple = (b0 << 16) | (b1 << 8) | b2;
+    *at++ = BASE64_CHARS[(triple >> 18) & 0x3F];
+    *at++ = BASE64_CHARS[(triple >> 12) & 0x3F];
+    *at++ = remaining > 1 ? BASE64_CHARS[(triple >> 6) & 0x3F] : '=';
+    *at++ = remaining > 2 ? BASE64_CHARS[triple & 0x3F] : '=';
+  }
+  return at - out;
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_DEFERRED
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_DEFERRED
+
+#include <cstdarg>
+#include <cstddef>
+
+namespace esphome {
+namespace logger {
+
+/// Start of the log lines carrying a deferred log record, see write_deferred_log().
+static const char *const DEFERRED_LOG_PREFIX = "~D";
+
+/** Write a log call as a deferred log line instead of formatting it.
+ *
+ * The line is DEFERRED_LOG_PREFIX followed by a base64 encoded record. The record holds the level, the line and the
+ * addresses of the tag and format strings, followed by the raw arguments in the order the format string consumes
+ * them. Formatting happens on the host, which looks the strings up in the firmware ELF (see deferred_log.py).
+ *
+ * @param out The buffer to write the line to, no null terminator is written.
+ * @param size The size of out, arguments that do not fit are left out of the record.
+ * @param format_ptr The address of the format string in the firmware image.
+ * @param format A readable copy of the format string.
+ * @return The number of characters written to out.
+ */
+size_t write_deferred_log(char *out, size_t size, int level, const char *tag, int line, const void *format_ptr,
+                          const char *format, va_list args);
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_DEFERRED
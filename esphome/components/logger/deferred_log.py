@@ -0,0 +1,230 @@
+"""Format the deferred log records of a logger with `deferred: true`.
+
+The device sends the addresses of the tag and format strings together with the raw
+arguments (see deferred_log.cpp), the strings are read from the firmware ELF.
+
+Only `esphome logs` decodes the records. Other log consumers get them as sent: the log
+view of Home Assistant shows the raw `~D` lines, and the logger rejects `on_message` and
+MQTT log forwarding together with `deferred: true`.
+"""
+
+from __future__ import annotations
+
+import base64
+import binascii
+import logging
+from pathlib import Path
+import re
+import struct
+
+from esphome.const import CONF_LOGGER
+
+_LOGGER = logging.getLogger(__name__)
+
+DEFERRED_LOG_PREFIX = "~D"
+DEFERRED_LOG_RE = re.compile(re.escape(DEFERRED_LOG_PREFIX) + r"([A-Za-z0-9+/=]+)")
+# flags, width, precision, length and conversion of a printf conversion specification
+CONVERSION_RE = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGaApn%])"
+)
+
+LOG_LEVEL_COLORS = [
+    "",
+    "\033[1;31m",
+    "\033[0;33m",
+    "\033[0;32m",
+    "\033[0;35m",
+    "\033[0;36m",
+    "\033[0;37m",
+    "\033[0;38m",
+]
+LOG_LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+LOG_RESET_COLOR = "\033[0m"
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+
+class _RecordTruncated(Exception):
+    pass
+
+
+class ElfStrings:
+    """Look up null terminated strings by their address in the loaded sections of an ELF file."""
+
+    def __init__(self, path: Path | str) -> None:
+        data = Path(path).read_bytes()
+        if data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+        self.is_64bit = data[4] == 2
+        self.endian = "<" if data[5] == 1 else ">"
+        if self.is_64bit:
+            (shoff,) = struct.unpack_from(f"{self.endian}Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(f"{self.endian}HH", data, 0x3A)
+            header_format = f"{self.endian}IQQQQ"
+        else:
+            (shoff,) = struct.unpack_from(f"{self.endian}I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(f"{self.endian}HH", data, 0x2E)
+            header_format = f"{self.endian}IIIII"
+        self.sections: list[tuple[int, bytes]] = []
+        for i in range(shnum):
+            sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from(
+                header_format, data, shoff + i * shentsize + 4
+            )
+            if sh_type == SHT_PROGBITS and sh_flags & SHF_ALLOC and sh_addr != 0:
+                self.sections.append((sh_addr, data[sh_offset : sh_offset + sh_size]))
+
+    def get_string(self, address: int) -> str | None:
+        for start, content in self.sections:
+            if start <= address < start + len(content):
+                offset = address - start
+                end = content.find(b"\0", offset)
+                if end == -1:
+                    end = len(content)
+                return content[offset:end].decode("utf8", "backslashreplace")
+        return None
+
+
+class _RecordReader:
+    def __init__(self, record: bytes, endian: str) -> None:
+        self.record = record
+        self.offset = 0
+        self.endian = endian
+
+    def read(self, fmt: str):
+        size = struct.calcsize(fmt)
+        if self.offset + size > len(self.record):
+            raise _RecordTruncated
+        (value,) = struct.unpack_from(f"{self.endian}{fmt}", self.record, self.offset)
+        self.offset += size
+        return value
+
+    def read_string(self) -> str:
+        end = self.record.find(b"\0", self.offset)
+        if end == -1:
+            raise _RecordTruncated
+        value = self.record[self.offset : end].decode("utf8", "backslashreplace")
+        self.offset = end + 1
+        return value
+
+
+class DeferredLogDecoder:
+    def __init__(self, elf_path: Path | str) -> None:
+        self.strings = ElfStrings(elf_path)
+        long_format = "q" if self.strings.is_64bit else "i"
+        self.integer_formats = {
+            None: "i",
+            "hh": "i",
+            "h": "i",
+            "l": long_format,
+            "ll": "q",
+            "j": "q",
+            "z": long_format,
+            "t": long_format,
+        }
+
+    def decode(self, line: str) -> str:
+        """Replace a deferred log record in the line with the formatted message."""
+        match = DEFERRED_LOG_RE.search(line)
+        if match is None:
+            return line
+        try:
+            record = base64.b64decode(match.group(1), validate=True)
+        except binascii.Error:
+            return line
+        return line[: match.start()] + self._format_record(record) + line[match.end() :]
+
+    def _format_record(self, record: bytes) -> str:
+        reader = _RecordReader(record, self.strings.endian)
+        try:
+            level = min(reader.read("B"), len(LOG_LEVEL_LETTERS) - 1)
+            line = reader.read("H")
+            tag_address = reader.read("I")
+            format_address = reader.read("I")
+        except _RecordTruncated:
+            return "<truncated log record>"
+
+        tag = self.strings.get_string(tag_address) or f"0x{tag_address:08x}"
+        header = (
+            f"{LOG_LEVEL_COLORS[level]}[{LOG_LEVEL_LETTERS[level]}][{tag}:{line:03}]: "
+        )
+        format_ = self.strings.get_string(format_address)
+        if format_ is None:
+            message = f"<unknown format string at 0x{format_address:08x}>"
+        else:
+            message = self._format_message(format_, reader)
+        return f"{header}{message.rstrip(chr(10))}{LOG_RESET_COLOR}"
+
+    def _format_message(self, format_: str, reader: _RecordReader) -> str:
+        parts: list[str] = []
+        position = 0
+        truncated = False
+        for match in CONVERSION_RE.finditer(format_):
+            parts.append(format_[position : match.start()])
+            position = match.end()
+            flags, width, precision, length, conversion = match.groups()
+            if conversion == "%":
+                parts.append("%")
+                continue
+            if truncated:
+                parts.append("?")
+                continue
+            try:
+                parts.append(
+                    self._format_argument(
+                        reader, flags, width, precision, length, conversion
+                    )
+                )
+            except _RecordTruncated:
+                truncated = True
+                parts.append("?")
+        parts.append(format_[position:])
+        return "".join(parts)
+
+    def _format_argument(self, reader, flags, width, precision, length, conversion):
+        if width == "*":
+            width = str(reader.read("i"))
+        if precision == "*":
+            precision = str(reader.read("i"))
+        spec = f"%{flags}{width or ''}"
+        if precision is not None:
+            spec += f".{precision}"
+        if conversion in "diouxXc":
+            value = reader.read(self.integer_formats[length].upper())
+            # char and short arguments are sent promoted to int
+            bits = {"hh": 8, "h": 16}.get(
+                length, struct.calcsize(self.integer_formats[length]) * 8
+            )
+            if conversion == "c":
+                bits = 8
+            value &= (1 << bits) - 1
+            if conversion in "di" and value >= 1 << (bits - 1):
+                value -= 1 << bits
+            if conversion == "c":
+                return (spec + "c") % value
+            return (spec + ("d" if conversion in "diu" else conversion)) % value
+        if conversion in "fFeEgGaA":
+            value = reader.read("d")
+            if conversion in "aA":
+                return value.hex()
+            return (spec + conversion) % value
+        if conversion == "s":
+            return (spec + "s") % reader.read_string()
+        if conversion == "p":
+            return f"0x{reader.read('I'):x}"
+        # %n writes instead of printing
+        return ""
+
+
+def get_deferred_log_decoder(config) -> DeferredLogDecoder | None:
+    """Get the decoder for the logs of this node, if it sends deferred log records."""
+    if not config.get(CONF_LOGGER, {}).get("deferred"):
+        return None
+    from esphome import platformio_api
+
+    elf_path = platformio_api.get_idedata(config).firmware_elf_path
+    try:
+        return DeferredLogDecoder(elf_path)
+    except (OSError, ValueError) as err:
+        _LOGGER.warning("Cannot decode deferred log records without firmware: %s", err)
+        return None
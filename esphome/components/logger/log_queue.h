@@ -0,0 +1,101 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace logger {
+
+/** Bounded lock-free queue of log messages, filled by any task and consumed in stages.
+ *
+ * Producers claim a slot, format their message directly into it and publish it. Each consumer stage (the UART writer
+ * task, then the log callbacks on the main loop) takes the messages in order once the previous stage is done with
+ * them, the last stage frees the slot again. Every slot carries a sequence number that encodes which position it holds
+ * and which stage it is at, so no locks are needed and producers never wait on a consumer.
+ */
+class LogQueue {
+ public:
+  struct Slot {
+    std::atomic<uint32_t> sequence;
+    uint32_t position;
+    int level;
+    const char *tag;
+    char *text;
+  };
+
+  /// Allocate the queue, slot_count is rounded down to a power of two of at least 4 (ensured by the config validation).
+  void init(size_t slot_count, size_t text_size, uint8_t stages) {
+    size_t count = 4;
+    while (count * 2 <= slot_count)
+      count *= 2;
+    this->mask_ = count - 1;
+    this->text_size_ = text_size;
+    this->stages_ = stages;
+    this->slots_ = std::unique_ptr<Slot[]>(new Slot[count]);  // NOLINT
+    this->text_ = std::unique_ptr<char[]>(new char[count * text_size]);  // NOLINT
+    for (size_t i = 0; i < count; i++) {
+      this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+      this->slots_[i].text = &this->text_[i * text_size];
+    }
+  }
+  bool is_initialized() const { return this->slots_ != nullptr; }
+  size_t get_text_size() const { return this->text_size_; }
+
+  /// Claim the next free slot to write a message into, returns nullptr if the queue is full.
+  Slot *claim() {
+    uint32_t pos = this->head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = this->slots_[pos & this->mask_];
+      const int32_t diff = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - pos);
+      if (diff == 0) {
+        if (this->head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.position = pos;
+          return &slot;
+        }
+      } else if (diff < 0) {
+        // still in use by a consumer from the previous round
+        return nullptr;
+      } else {
+        // another producer claimed it
+        pos = this->head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  /// Hand a claimed slot over to the first consumer stage.
+  void publish(Slot *slot) { slot->sequence.store(slot->position + 1, std::memory_order_release); }
+
+  /// Get the next message for the given consumer stage, returns nullptr if there is none yet.
+  Slot *peek(uint8_t stage) {
+    const uint32_t pos = this->tails_[stage];
+    Slot &slot = this->slots_[pos & this->mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1 + stage)
+      return nullptr;
+    return &slot;
+  }
+  /// Pass the message returned by peek() on to the next stage, the last stage frees the slot.
+  void release(uint8_t stage) {
+    const uint32_t pos = this->tails_[stage]++;
+    const uint32_t next = stage + 1 == this->stages_ ? pos + this->mask_ + 1 : pos + 2 + stage;
+    this->slots_[pos & this->mask_].sequence.store(next, std::memory_order_release);
+  }
+
+ protected:
+  std::unique_ptr<Slot[]> slots_;
+  std::unique_ptr<char[]> text_;
+  std::atomic<uint32_t> head_{0};
+  uint32_t tails_[2]{0, 0};
+  uint32_t mask_{0};
+  size_t text_size_{0};
+  uint8_t stages_{1};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
@@ -1,6 +1,11 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
 
+#ifdef USE_LOGGER_DEFERRED
+#include "deferred_log.h"
+#endif
+
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
@@ -32,6 +37,13 @@ static const char *const LOG_LEVEL_LETTERS[] = {
 };
 
 void Logger::write_header_(int level, const char *tag, int line) {
+  if (this->is_buffer_full_())
+    return;
+  this->tx_buffer_at_ += this->format_header_(this->tx_buffer_ + this->tx_buffer_at_, this->buffer_remaining_capacity_(),
+                                              level, tag, line);
+}
+
+int Logger::format_header_(char *buffer, int size, int level, const char *tag, int line) {
   if (level < 0)
     level = 0;
   if (level > 7)
@@ -44,8 +56,9 @@ void Logger::write_header_(int level, const char *tag, int line) {
 #else
   void *current_task = nullptr;
 #endif
+  int ret;
   if (current_task == main_task_) {
-    this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
+    ret = snprintf(buffer, size, "%s[%s][%s:%03u]: ", color, letter, tag, line);
   } else {
     const char *thread_name = "";
 #if defined(USE_ESP32)
@@ -53,20 +66,36 @@ void Logger::write_header_(int level, const char *tag, int line) {
 #elif defined(USE_LIBRETINY)
     thread_name = pcTaskGetTaskName(current_task);
 #endif
-    this->printf_to_buffer_("%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
-                            ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
+    ret = snprintf(buffer, size, "%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
+                   ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
   }
+  if (ret < 0)
+    return 0;
+  // output was too long, truncated
+  return std::min(ret, size);
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+#ifdef USE_LOGGER_ASYNC
+  if (this->log_queue_.is_initialized()) {
+    this->queue_message_(level, tag, line, format, args);
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
   this->reset_buffer_();
+#ifdef USE_LOGGER_DEFERRED
+  this->write_deferred_(level, tag, line, format, format, args);
+#else
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
   this->write_footer_();
+#endif
   this->log_message_(level, tag);
   recursion_guard_ = false;
 }
@@ -92,25 +121,124 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   // length of format string, includes null terminator
   uint32_t offset = this->tx_buffer_at_;
 
+#ifdef USE_LOGGER_DEFERRED
+  this->write_deferred_(level, tag, line, format, this->tx_buffer_, args);
+#else
   // now apply vsnprintf
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(this->tx_buffer_, args);
   this->write_footer_();
+#endif
   this->log_message_(level, tag, offset);
   recursion_guard_ = false;
 }
 #endif
 
-int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
-  for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
-      return it.level;
+#ifdef USE_LOGGER_ASYNC
+void HOT Logger::queue_message_(int level, const char *tag, int line, const char *format, va_list args) {
+  const bool main_task = xTaskGetCurrentTaskHandle() == this->main_task_;
+  if (main_task && this->recursion_guard_)
+    return;
+
+  LogQueue::Slot *slot = this->log_queue_.claim();
+  if (slot == nullptr) {
+    // never wait for room, not even on the main loop. The next loop() drains the queue and reports the count
+    this->dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // keep one byte for the null terminator
+  const int size = this->log_queue_.get_text_size() - 1;
+  char *text = slot->text;
+#ifdef USE_LOGGER_DEFERRED
+  int at = write_deferred_log(text, size, level, tag, line, format, format, args);
+#else
+  int at = this->format_header_(text, size, level, tag, line);
+  if (at < size) {
+    int ret = vsnprintf(text + at, size - at, format, args);
+    if (ret > 0)
+      at = std::min(at + ret, size);
+  }
+  const int footer_len = std::min<int>(strlen(ESPHOME_LOG_RESET_COLOR), size - at);
+  memcpy(text + at, ESPHOME_LOG_RESET_COLOR, footer_len);
+  at += footer_len;
+#endif
+  // remove trailing newline
+  if (at > 0 && text[at - 1] == '\n')
+    at--;
+  text[at] = '\0';
+  slot->level = level;
+  slot->tag = tag;
+  this->log_queue_.publish(slot);
+  if (this->uart_task_handle_ != nullptr)
+    xTaskNotifyGive(this->uart_task_handle_);
+}
+
+void Logger::deliver_queued_messages_() {
+  const uint8_t stage = this->uart_task_handle_ != nullptr ? 1 : 0;
+  this->recursion_guard_ = true;
+  LogQueue::Slot *slot;
+  while ((slot = this->log_queue_.peek(stage)) != nullptr) {
+    // See log_message_()
+    if (xPortGetFreeHeapSize() >= 2048)
+      this->log_callback_.call(slot->level, slot->tag, slot->text);
+    this->log_queue_.release(stage);
+  }
+  this->recursion_guard_ = false;
+
+  const uint32_t dropped = this->dropped_messages_.exchange(0, std::memory_order_relaxed);
+  if (dropped != 0) {
+    ESP_LOGW(TAG, "Dropped %" PRIu32 " log messages, the log queue was full", dropped);
+  }
+}
+
+void Logger::uart_task(void *param) {
+  auto *logger = static_cast<Logger *>(param);
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  while (true) {
+    LogQueue::Slot *slot = logger->log_queue_.peek(0);
+    if (slot == nullptr) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
     }
+    logger->write_msg_(slot->text);
+    logger->log_queue_.release(0);
+  }
+}
+#endif
+
+#ifdef USE_LOGGER_DEFERRED
+void HOT Logger::write_deferred_(int level, const char *tag, int line, const void *format_ptr, const char *format,
+                                 va_list args) {
+  if (this->is_buffer_full_())
+    return;
+  this->tx_buffer_at_ += write_deferred_log(this->tx_buffer_ + this->tx_buffer_at_, this->buffer_remaining_capacity_(),
+                                            level, tag, line, format_ptr, format, args);
+}
+#endif
+
+/// FNV-1 hash of a tag, the same as tag_hash() in __init__.py. Unlike fnv1_hash(), it doesn't depend on whether char
+/// is signed on the platform.
+static inline uint32_t tag_hash(const char *tag) {
+  uint32_t hash = 2166136261UL;
+  for (; *tag != '\0'; tag++) {
+    hash *= 16777619UL;
+    hash ^= static_cast<uint8_t>(*tag);
+  }
+  return hash;
+}
+
+int HOT Logger::level_for(const char *tag) {
+  if (this->tag_levels_ == nullptr)
+    return ESPHOME_LOG_LEVEL;
+  const uint32_t hash = tag_hash(tag);
+  for (size_t i = hash & this->tag_levels_mask_;; i = (i + 1) & this->tag_levels_mask_) {
+    const TagLogLevel &entry = this->tag_levels_[i];
+    if (entry.tag == nullptr)
+      return ESPHOME_LOG_LEVEL;
+    if (entry.hash == hash && strcmp(entry.tag, tag) == 0)
+      return entry.level;
   }
-  return ESPHOME_LOG_LEVEL;
 }
 
 void HOT Logger::log_message_(int level, const char *tag, int offset) {
@@ -148,9 +276,13 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate
 #endif
 }
 
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_ASYNC)
 void Logger::loop() {
-#ifdef USE_ARDUINO
+#ifdef USE_LOGGER_ASYNC
+  if (this->log_queue_.is_initialized())
+    this->deliver_queued_messages_();
+#endif
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
   if (this->uart_ != UART_SELECTION_USB_CDC) {
     return;
   }
@@ -167,9 +299,6 @@ void Logger::loop() {
 #endif
 
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
-void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
-}
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
 UARTSelection Logger::get_uart() const { return this->uart_; }
@@ -184,13 +313,23 @@ const char *const LOG_LEVELS[] = {"NONE", "ERROR", "WARN", "INFO", "CONFIG", "DE
 void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "Logger:");
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
+#ifdef USE_LOGGER_DEFERRED
+  ESP_LOGCONFIG(TAG, "  Deferred formatting: YES");
+#endif
+#ifdef USE_LOGGER_ASYNC
+  ESP_LOGCONFIG(TAG, "  Async buffer size: %u bytes", (unsigned) this->async_buffer_size_);
+#endif
 #ifndef USE_HOST
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %" PRIu32, this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", get_uart_selection_());
 #endif
 
-  for (auto &it : this->log_levels_) {
-    ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
+  if (this->tag_levels_ != nullptr) {
+    for (size_t i = 0; i <= this->tag_levels_mask_; i++) {
+      const TagLogLevel &entry = this->tag_levels_[i];
+      if (entry.tag != nullptr)
+        ESP_LOGCONFIG(TAG, "  Level for '%s': %s", entry.tag, LOG_LEVELS[entry.level]);
+    }
   }
 }
 void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
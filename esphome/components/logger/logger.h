@@ -21,6 +21,10 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#ifdef USE_LOGGER_ASYNC
+#include "log_queue.h"
+#endif
+
 namespace esphome {
 
 namespace logger {
@@ -53,10 +57,17 @@ enum UARTSelection {
 };
 #endif  // USE_ESP32 || USE_ESP8266 || USE_RP2040 || USE_LIBRETINY
 
+/// One slot of the tag log level table generated by codegen, empty slots have no tag.
+struct TagLogLevel {
+  const char *tag;
+  uint32_t hash;
+  int level;
+};
+
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_ASYNC)
   void loop() override;
 #endif
   /// Manually set the baud rate for serial, set to 0 to disable.
@@ -74,8 +85,25 @@ class Logger : public Component {
   UARTSelection get_uart() const;
 #endif
 
-  /// Set the log level of the specified tag.
-  void set_log_level(const std::string &tag, int log_level);
+#ifdef USE_LOGGER_ASYNC
+  /** Queue log messages and write them from a separate task instead of the calling one.
+   *
+   * The UART is written by a low priority task and the log callbacks (API, MQTT, triggers) run in loop(), so a log
+   * call never waits on the UART and messages of other tasks reach the callbacks in the main loop context. Messages
+   * that do not fit into a full queue are dropped and counted, whichever task logs them.
+   */
+  void set_async_buffer_size(size_t async_buffer_size) { this->async_buffer_size_ = async_buffer_size; }
+#endif
+
+  /** Set the table with the log levels of specific tags.
+   *
+   * The table is an open addressing hash table on the FNV-1 hash of the tag with linear probing, built by codegen. Its
+   * size must be a power of two and it must have at least one empty slot.
+   */
+  void set_tag_levels(const TagLogLevel *tag_levels, size_t size) {
+    this->tag_levels_ = tag_levels;
+    this->tag_levels_mask_ = size - 1;
+  }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -97,9 +125,25 @@ class Logger : public Component {
 
  protected:
   void write_header_(int level, const char *tag, int line);
+  /// Format the log line header into buffer, returns the number of characters written.
+  int format_header_(char *buffer, int size, int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
   void write_msg_(const char *msg);
+#ifdef USE_LOGGER_ASYNC
+  /// Start the queue and the UART task, called by pre_setup().
+  void start_async_();
+  /// Format the message into the log queue, callable from any task.
+  void queue_message_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Run the log callbacks for the queued messages, main loop only.
+  void deliver_queued_messages_();
+  static void uart_task(void *param);
+#endif
+#ifdef USE_LOGGER_DEFERRED
+  /// Write the log call as a deferred record for the host to format, see write_deferred_log().
+  void write_deferred_(int level, const char *tag, int line, const void *format_ptr, const char *format,
+                       va_list args);
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -159,15 +203,19 @@ class Logger : public Component {
 #ifdef USE_ESP_IDF
   uart_port_t uart_num_;
 #endif
-  struct LogLevelOverride {
-    std::string tag;
-    int level;
-  };
-  std::vector<LogLevelOverride> log_levels_;
+  const TagLogLevel *tag_levels_{nullptr};
+  size_t tag_levels_mask_{0};
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
   void *main_task_ = nullptr;
+#ifdef USE_LOGGER_ASYNC
+  LogQueue log_queue_;
+  size_t async_buffer_size_{4096};
+  TaskHandle_t uart_task_handle_{nullptr};
+  /// Messages that did not fit into the queue since the last loop().
+  std::atomic<uint32_t> dropped_messages_{0};
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
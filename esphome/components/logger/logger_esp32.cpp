@@ -167,10 +167,28 @@ void Logger::pre_setup() {
     esp_log_level_set("*", ESP_LOG_VERBOSE);
   }
 #endif  // USE_ESP_IDF || USE_ESP32_FRAMEWORK_ARDUINO
+#ifdef USE_LOGGER_ASYNC
+  this->start_async_();
+#endif
 
   ESP_LOGI(TAG, "Log initialized");
 }
 
+#ifdef USE_LOGGER_ASYNC
+void Logger::start_async_() {
+  // the task waits for the first notification before it touches the queue
+  if (this->baud_rate_ > 0 &&
+      xTaskCreate(Logger::uart_task, "logger", 3072, this, tskIDLE_PRIORITY + 1, &this->uart_task_handle_) != pdPASS) {
+    this->uart_task_handle_ = nullptr;
+  }
+  const size_t text_size = this->tx_buffer_size_ + 1;
+  // without the UART task the log callbacks are the only consumer
+  this->log_queue_.init(this->async_buffer_size_ / text_size, text_size, this->uart_task_handle_ != nullptr ? 2 : 1);
+  if (this->uart_task_handle_ != nullptr)
+    xTaskNotifyGive(this->uart_task_handle_);
+}
+#endif
+
 #ifdef USE_ESP_IDF
 void HOT Logger::write_msg_(const char *msg) {
   if (
@@ -27,6 +27,9 @@ bool CustomMQTTDevice::publish_json(const std::string &topic, const json::json_b
 bool CustomMQTTDevice::publish_json(const std::string &topic, const json::json_build_t &f) {
   return this->publish_json(topic, f, 0, false);
 }
+bool CustomMQTTDevice::publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos, bool retain) {
+  return global_mqtt_client->publish_json(topic, f, qos, retain);
+}
 bool CustomMQTTDevice::is_connected() { return global_mqtt_client != nullptr && global_mqtt_client->is_connected(); }
 
 }  // namespace mqtt
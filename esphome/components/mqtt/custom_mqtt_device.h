@@ -183,6 +183,28 @@ class CustomMQTTDevice {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f);
 
+  /** Publish a JSON-encoded MQTT message written in a single pass with the given Quality of Service and retain
+   * settings.
+   *
+   * Example:
+   *
+   * ```cpp
+   * void in_some_method() {
+   *   publish_json("the/topic", [=](json::JsonWriter &writer) {
+   *     writer.begin_object();
+   *     writer.add("the_key", "Hello World!");
+   *     writer.end_object();
+   *   }, 0, false);
+   * }
+   * ```
+   *
+   * @param topic The topic to publish to.
+   * @param f The function writing the payload.
+   * @param qos The Quality of Service to publish with.
+   * @param retain Whether to retain the message.
+   */
+  bool publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos = 0, bool retain = false);
+
   /// Check whether the MQTT client is currently connected and messages can be published.
   bool is_connected();
 };
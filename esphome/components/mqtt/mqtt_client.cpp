@@ -445,6 +445,27 @@ void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_js
   this->subscriptions_.push_back(subscription);
 }
 
+void MQTTClientComponent::subscribe_json_values(const std::string &topic, const mqtt_json_value_callback_t &callback,
+                                                uint8_t qos) {
+  auto f = [callback](const std::string &topic, const std::string &payload) {
+    bool valid = json::parse_json_values(
+        payload, [&topic, &callback](const char *path, json::JsonValueType type, const char *value) {
+          callback(topic, path, type, value);
+        });
+    if (!valid)
+      ESP_LOGW(TAG, "Invalid JSON payload on topic '%s'", topic.c_str());
+  };
+  MQTTSubscription subscription{
+      .topic = topic,
+      .qos = qos,
+      .callback = f,
+      .subscribed = false,
+      .resubscribe_timeout = 0,
+  };
+  this->resubscribe_subscription_(&subscription);
+  this->subscriptions_.push_back(subscription);
+}
+
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
   bool ret = this->mqtt_backend_.unsubscribe(topic.c_str());
   yield();
@@ -507,6 +528,11 @@ bool MQTTClientComponent::publish_json(const std::string &topic, const json::jso
   std::string message = json::build_json(f);
   return this->publish(topic, message, qos, retain);
 }
+bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos,
+                                       bool retain) {
+  std::string message = json::write_json(f);
+  return this->publish(topic, message, qos, retain);
+}
 
 void MQTTClientComponent::enable() {
   if (this->state_ != MQTT_CLIENT_DISABLED)
@@ -34,6 +34,8 @@ using mqtt_on_disconnect_callback_t = std::function<MQTTBackend::on_disconnect_c
  */
 using mqtt_callback_t = std::function<void(const std::string &, const std::string &)>;
 using mqtt_json_callback_t = std::function<void(const std::string &, JsonObject)>;
+using mqtt_json_value_callback_t =
+    std::function<void(const std::string &topic, const char *path, json::JsonValueType type, const char *value)>;
 
 /// internal struct for MQTT subscriptions.
 struct MQTTSubscription {
@@ -195,6 +197,18 @@ class MQTTClientComponent : public Component {
    */
   void subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos = 0);
 
+  /** Subscribe to a MQTT topic and parse the JSON payload value by value.
+   *
+   * The payload is parsed with a json::JsonStreamParser instead of into a JsonObject, so large payloads do not need
+   * additional memory. The callback is called for every value, with its path in the payload, up to the point where
+   * the payload turns out to be invalid.
+   *
+   * @param topic The topic. Wildcards are currently not supported.
+   * @param callback The callback that will be called with every value of a message with matching topic.
+   * @param qos The QoS of this subscription.
+   */
+  void subscribe_json_values(const std::string &topic, const mqtt_json_value_callback_t &callback, uint8_t qos = 0);
+
   /** Unsubscribe from an MQTT topic.
    *
    * If multiple existing subscriptions to the same topic exist, all of them will be removed.
@@ -229,6 +243,14 @@ class MQTTClientComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false);
 
+  /** Write and send a JSON MQTT message in a single pass, without building a JSON document first.
+   *
+   * @param topic The topic.
+   * @param f The Json Message writer.
+   * @param retain Whether to retain the message.
+   */
+  bool publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos = 0, bool retain = false);
+
   /// Setup the MQTT client, registering a bunch of callbacks and attempting to connect.
   void setup() override;
   void dump_config() override;
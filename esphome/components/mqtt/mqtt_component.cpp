@@ -59,6 +59,11 @@ bool MQTTComponent::publish_json(const std::string &topic, const json::json_buil
     return false;
   return global_mqtt_client->publish_json(topic, f, this->qos_, this->retain_);
 }
+bool MQTTComponent::publish_json(const std::string &topic, const json::json_write_t &f) {
+  if (topic.empty())
+    return false;
+  return global_mqtt_client->publish_json(topic, f, this->qos_, this->retain_);
+}
 
 bool MQTTComponent::send_discovery_() {
   const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
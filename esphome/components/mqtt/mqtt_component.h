@@ -129,6 +129,13 @@ class MQTTComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f);
 
+  /** Write and send a JSON MQTT message in a single pass.
+   *
+   * @param topic The topic.
+   * @param f The Json Message writer.
+   */
+  bool publish_json(const std::string &topic, const json::json_write_t &f);
+
   /** Subscribe to a MQTT topic.
    *
    * @param topic The topic. Wildcards are currently not supported.
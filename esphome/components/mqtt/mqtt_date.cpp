@@ -54,10 +54,12 @@ bool MQTTDateComponent::send_initial_state() {
   }
 }
 bool MQTTDateComponent::publish_state(uint16_t year, uint8_t month, uint8_t day) {
-  return this->publish_json(this->get_state_topic_(), [year, month, day](JsonObject root) {
-    root["year"] = year;
-    root["month"] = month;
-    root["day"] = day;
+  return this->publish_json(this->get_state_topic_(), [year, month, day](json::JsonWriter &writer) {
+    writer.begin_object();
+    writer.add("year", year);
+    writer.add("month", month);
+    writer.add("day", day);
+    writer.end_object();
   });
 }
 
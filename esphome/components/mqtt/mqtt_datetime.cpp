@@ -67,13 +67,15 @@ bool MQTTDateTimeComponent::send_initial_state() {
 }
 bool MQTTDateTimeComponent::publish_state(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute,
                                           uint8_t second) {
-  return this->publish_json(this->get_state_topic_(), [year, month, day, hour, minute, second](JsonObject root) {
-    root["year"] = year;
-    root["month"] = month;
-    root["day"] = day;
-    root["hour"] = hour;
-    root["minute"] = minute;
-    root["second"] = second;
+  return this->publish_json(this->get_state_topic_(), [year, month, day, hour, minute, second](json::JsonWriter &writer) {
+    writer.begin_object();
+    writer.add("year", year);
+    writer.add("month", month);
+    writer.add("day", day);
+    writer.add("hour", hour);
+    writer.add("minute", minute);
+    writer.add("second", second);
+    writer.end_object();
   });
 }
 
@@ -40,8 +40,11 @@ void MQTTEventComponent::dump_config() {
 }
 
 bool MQTTEventComponent::publish_event_(const std::string &event_type) {
-  return this->publish_json(this->get_state_topic_(),
-                            [event_type](JsonObject root) { root[MQTT_EVENT_TYPE] = event_type; });
+  return this->publish_json(this->get_state_topic_(), [&event_type](json::JsonWriter &writer) {
+    writer.begin_object();
+    writer.add(MQTT_EVENT_TYPE, event_type);
+    writer.end_object();
+  });
 }
 
 std::string MQTTEventComponent::component_type() const { return "event"; }
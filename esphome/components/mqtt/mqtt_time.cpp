@@ -54,10 +54,12 @@ bool MQTTTimeComponent::send_initial_state() {
   }
 }
 bool MQTTTimeComponent::publish_state(uint8_t hour, uint8_t minute, uint8_t second) {
-  return this->publish_json(this->get_state_topic_(), [hour, minute, second](JsonObject root) {
-    root["hour"] = hour;
-    root["minute"] = minute;
-    root["second"] = second;
+  return this->publish_json(this->get_state_topic_(), [hour, minute, second](json::JsonWriter &writer) {
+    writer.begin_object();
+    writer.add("hour", hour);
+    writer.add("minute", minute);
+    writer.add("second", second);
+    writer.end_object();
   });
 }
 
@@ -29,14 +29,16 @@ void MQTTUpdateComponent::setup() {
 }
 
 bool MQTTUpdateComponent::publish_state() {
-  return this->publish_json(this->get_state_topic_(), [this](JsonObject root) {
-    root["installed_version"] = this->update_->update_info.current_version;
-    root["latest_version"] = this->update_->update_info.latest_version;
-    root["title"] = this->update_->update_info.title;
+  return this->publish_json(this->get_state_topic_(), [this](json::JsonWriter &writer) {
+    writer.begin_object();
+    writer.add("installed_version", this->update_->update_info.current_version);
+    writer.add("latest_version", this->update_->update_info.latest_version);
+    writer.add("title", this->update_->update_info.title);
     if (!this->update_->update_info.summary.empty())
-      root["release_summary"] = this->update_->update_info.summary;
+      writer.add("release_summary", this->update_->update_info.summary);
     if (!this->update_->update_info.release_url.empty())
-      root["release_url"] = this->update_->update_info.release_url;
+      writer.add("release_url", this->update_->update_info.release_url);
+    writer.end_object();
   });
 }
 
@@ -8,12 +8,14 @@ preferences_ns = cg.esphome_ns.namespace("preferences")
 IntervalSyncer = preferences_ns.class_("IntervalSyncer", cg.Component)
 
 CONF_FLASH_WRITE_INTERVAL = "flash_write_interval"
+CONF_FLASH_WRITE_BUDGET = "flash_write_budget"
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(IntervalSyncer),
         cv.Optional(
             CONF_FLASH_WRITE_INTERVAL, default="60s"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_FLASH_WRITE_BUDGET): cv.positive_time_period_milliseconds,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -21,4 +23,6 @@ CONFIG_SCHEMA = cv.Schema(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_write_interval(config[CONF_FLASH_WRITE_INTERVAL]))
+    if CONF_FLASH_WRITE_BUDGET in config:
+        cg.add(var.set_write_budget(config[CONF_FLASH_WRITE_BUDGET]))
     await cg.register_component(var, config)
@@ -9,14 +9,32 @@ namespace preferences {
 class IntervalSyncer : public Component {
  public:
   void set_write_interval(uint32_t write_interval) { write_interval_ = write_interval; }
+  /// Spend at most about this many ms per loop iteration on flash writes, 0 writes everything at once.
+  void set_write_budget(uint32_t write_budget) { write_budget_ = write_budget; }
   void setup() override {
-    set_interval(write_interval_, []() { global_preferences->sync(); });
+    if (write_budget_ == 0) {
+      set_interval(write_interval_, []() { global_preferences->sync(); });
+    } else {
+      set_interval(write_interval_, [this]() {
+        this->pending_sync_ = true;
+        this->enable_loop();
+      });
+    }
+  }
+  void loop() override {
+    if (pending_sync_ && !global_preferences->sync_partial(write_budget_))
+      return;
+    // nothing left to write until the next interval
+    pending_sync_ = false;
+    this->disable_loop();
   }
   void on_shutdown() override { global_preferences->sync(); }
   float get_setup_priority() const override { return setup_priority::BUS; }
 
  protected:
   uint32_t write_interval_;
+  uint32_t write_budget_{0};
+  bool pending_sync_{false};
 };
 
 }  // namespace preferences
@@ -21,7 +21,10 @@ struct ParseResult {
 
 class PVVXMiThermometer : public Component, public esp32_ble_tracker::ESPBTDeviceListener {
  public:
-  void set_address(uint64_t address) { address_ = address; };
+  void set_address(uint64_t address) {
+    address_ = address;
+    this->add_filter_address(address);
+  };
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
   void dump_config() override;
@@ -12,7 +12,10 @@ namespace ruuvitag {
 
 class RuuviTag : public Component, public esp32_ble_tracker::ESPBTDeviceListener {
  public:
-  void set_address(uint64_t address) { address_ = address; }
+  void set_address(uint64_t address) {
+    address_ = address;
+    this->add_filter_address(address);
+  }
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
     if (device.address_uint64() != this->address_)
@@ -41,6 +41,8 @@ void SafeModeComponent::loop() {
     ESP_LOGI(TAG, "Boot seems successful; resetting boot loop counter");
     this->clean_rtc();
     this->boot_successful_ = true;
+    // Nothing left to do
+    this->disable_loop();
   }
 }
 
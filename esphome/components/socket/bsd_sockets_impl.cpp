@@ -114,6 +114,8 @@ class BSDSocketImpl : public Socket {
     return ::sendto(fd_, buf, len, flags, to, tolen);
   }
 
+  int get_fd() const override { return this->fd_; }
+
   int setblocking(bool blocking) override {
     int fl = ::fcntl(fd_, F_GETFL, 0);
     if (blocking) {
@@ -86,6 +86,8 @@ class LwIPSocketImpl : public Socket {
   ssize_t sendto(const void *buf, size_t len, int flags, const struct sockaddr *to, socklen_t tolen) override {
     return lwip_sendto(fd_, buf, len, flags, to, tolen);
   }
+  int get_fd() const override { return this->fd_; }
+
   int setblocking(bool blocking) override {
     int fl = lwip_fcntl(fd_, F_GETFL, 0);
     if (blocking) {
@@ -42,6 +42,9 @@ class Socket {
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+
+  /// Get the file descriptor of the socket, or -1 if the implementation does not use file descriptors.
+  virtual int get_fd() const { return -1; }
 };
 
 /// Create a socket of the given domain, type and protocol.
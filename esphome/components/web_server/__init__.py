@@ -38,6 +38,7 @@ AUTO_LOAD = ["json", "web_server_base"]
 CONF_SORTING_GROUP_ID = "sorting_group_id"
 CONF_SORTING_GROUPS = "sorting_groups"
 CONF_SORTING_WEIGHT = "sorting_weight"
+CONF_COMPACT_EVENTS = "compact_events"
 
 web_server_ns = cg.esphome_ns.namespace("web_server")
 WebServer = web_server_ns.class_("WebServer", cg.Component, cg.Controller)
@@ -85,6 +86,21 @@ def validate_sorting_groups(config):
     return config
 
 
+def validate_compact_events(config):
+    if not config[CONF_COMPACT_EVENTS]:
+        return config
+    if config[CONF_VERSION] != 3:
+        raise cv.Invalid(
+            f"'{CONF_COMPACT_EVENTS}' is only supported in 'web_server' version 3"
+        )
+    # The default frontend does not handle the compact "states" events
+    if CONF_JS_URL not in config and CONF_JS_INCLUDE not in config:
+        raise cv.Invalid(
+            f"'{CONF_COMPACT_EVENTS}' requires '{CONF_JS_URL}' or '{CONF_JS_INCLUDE}'"
+        )
+    return config
+
+
 def _validate_no_sorting_component(
     sorting_component: str,
     webserver_version: int,
@@ -185,9 +201,12 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_LOG, default=True): cv.boolean,
             cv.Optional(CONF_LOCAL): cv.boolean,
             cv.Optional(CONF_SORTING_GROUPS): cv.ensure_list(sorting_group),
+            cv.Optional(CONF_COMPACT_EVENTS, default=False): cv.boolean,
         }
     ).extend(cv.COMPONENT_SCHEMA),
     cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_BK72XX, PLATFORM_RTL87XX]),
+    # before default_url, which fills in the default js_url
+    validate_compact_events,
     default_url,
     validate_local,
     validate_ota,
@@ -294,6 +313,8 @@ async def to_code(config):
     cg.add(var.set_include_internal(config[CONF_INCLUDE_INTERNAL]))
     if CONF_LOCAL in config and config[CONF_LOCAL]:
         cg.add_define("USE_WEBSERVER_LOCAL")
+    if config[CONF_COMPACT_EVENTS]:
+        cg.add_define("USE_WEBSERVER_COMPACT_EVENTS")
 
     if (sorting_group_config := config.get(CONF_SORTING_GROUPS)) is not None:
         add_sorting_groups(var, sorting_group_config)
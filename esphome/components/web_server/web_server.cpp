@@ -39,6 +39,11 @@ namespace web_server {
 
 static const char *const TAG = "web_server";
 
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+/// Time in ms over which compact state updates are collected into one event.
+static const uint32_t COMPACT_EVENTS_INTERVAL = 100;
+#endif
+
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
 static const char *const HEADER_PNA_NAME = "Private-Network-Access-Name";
 static const char *const HEADER_PNA_ID = "Private-Network-Access-ID";
@@ -148,6 +153,13 @@ void WebServer::loop() {
   }
 #endif
   this->entities_iterator_.advance();
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+  const uint32_t now = millis();
+  if (!this->compact_order_.empty() && now - this->last_compact_flush_ >= COMPACT_EVENTS_INTERVAL) {
+    this->flush_compact_states_();
+    this->last_compact_flush_ = now;
+  }
+#endif
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
@@ -217,11 +229,84 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
   set_json_value(root, obj, sensor, value, start_config); \
   (root)["state"] = state;
 
+void WebServer::write_json_id_(json::JsonWriter &writer, EntityBase *obj, const std::string &id,
+                               JsonDetail start_config) {
+  writer.add("id", id);
+  if (start_config == DETAIL_ALL) {
+    writer.add("name", obj->get_name());
+    writer.add("icon", obj->get_icon());
+    writer.add("entity_category", static_cast<uint8_t>(obj->get_entity_category()));
+    if (obj->is_disabled_by_default())
+      writer.add("is_disabled_by_default", true);
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+    writer.add("idx", obj->get_entity_index());
+#endif
+  }
+}
+
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+template<typename T> void WebServer::queue_compact_state_(EntityBase *obj, T value, const std::string &state) {
+  const uint16_t index = obj->get_entity_index();
+  if (this->compact_states_.size() != App.get_entity_count())
+    this->compact_states_.resize(App.get_entity_count());
+  if (index >= this->compact_states_.size())
+    return;
+  std::string &pending = this->compact_states_[index];
+  if (pending.empty())
+    this->compact_order_.push_back(index);
+  // a newer state replaces one that was not sent yet
+  pending = json::write_json([index, value, &state](json::JsonWriter &writer) {
+    writer.begin_array();
+    writer.value(index);
+    writer.value(value);
+    writer.value(state);
+    writer.end_array();
+  });
+}
+
+void WebServer::flush_compact_states_() {
+  std::string batch = "[";
+  for (uint16_t index : this->compact_order_) {
+    std::string &pending = this->compact_states_[index];
+    if (batch.size() > 1)
+      batch += ',';
+    batch += pending;
+    pending.clear();
+  }
+  batch += ']';
+  this->compact_order_.clear();
+  this->events_.send(batch.c_str(), "states");
+}
+#endif
+
+void WebServer::write_json_sorting_(json::JsonWriter &writer, EntityBase *obj) {
+  auto entity = this->sorting_entitys_.find(obj);
+  if (entity == this->sorting_entitys_.end())
+    return;
+  writer.add("sorting_weight", entity->second.weight);
+  auto group = this->sorting_groups_.find(entity->second.group_id);
+  if (group != this->sorting_groups_.end())
+    writer.add("sorting_group", group->second.name);
+}
+
 #ifdef USE_SENSOR
+static std::string sensor_state_string(sensor::Sensor *obj, float value) {
+  if (std::isnan(value))
+    return "NA";
+  std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
+  if (!obj->get_unit_of_measurement().empty())
+    state += " " + obj->get_unit_of_measurement();
+  return state;
+}
+
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
   if (this->events_.count() == 0)
     return;
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+  this->queue_compact_state_(obj, state, sensor_state_string(obj, state));
+#else
   this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+#endif
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
@@ -241,26 +326,17 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    std::string state;
-    if (std::isnan(value)) {
-      state = "NA";
-    } else {
-      state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-      if (!obj->get_unit_of_measurement().empty())
-        state += " " + obj->get_unit_of_measurement();
-    }
-    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
+  return json::write_json([this, obj, value, start_config](json::JsonWriter &writer) {
+    writer.begin_object();
+    this->write_json_id_(writer, obj, "sensor-" + obj->get_object_id(), start_config);
+    writer.add("value", value);
+    writer.add("state", sensor_state_string(obj, value));
     if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
+      this->write_json_sorting_(writer, obj);
       if (!obj->get_unit_of_measurement().empty())
-        root["uom"] = obj->get_unit_of_measurement();
+        writer.add("uom", obj->get_unit_of_measurement());
     }
+    writer.end_object();
   });
 }
 #endif
@@ -269,7 +345,11 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
   if (this->events_.count() == 0)
     return;
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+  this->queue_compact_state_(obj, state, state);
+#else
   this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+#endif
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
@@ -290,16 +370,14 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
+  return json::write_json([this, obj, &value, start_config](json::JsonWriter &writer) {
+    writer.begin_object();
+    this->write_json_id_(writer, obj, "text_sensor-" + obj->get_object_id(), start_config);
+    writer.add("value", value);
+    writer.add("state", value);
+    if (start_config == DETAIL_ALL)
+      this->write_json_sorting_(writer, obj);
+    writer.end_object();
   });
 }
 #endif
@@ -308,7 +386,11 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
   if (this->events_.count() == 0)
     return;
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+  this->queue_compact_state_(obj, state, state ? "ON" : "OFF");
+#else
   this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+#endif
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (switch_::Switch *obj : App.get_switches()) {
@@ -340,17 +422,16 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
+  return json::write_json([this, obj, value, start_config](json::JsonWriter &writer) {
+    writer.begin_object();
+    this->write_json_id_(writer, obj, "switch-" + obj->get_object_id(), start_config);
+    writer.add("value", value);
+    writer.add("state", value ? "ON" : "OFF");
     if (start_config == DETAIL_ALL) {
-      root["assumed_state"] = obj->assumed_state();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
+      writer.add("assumed_state", obj->assumed_state());
+      this->write_json_sorting_(writer, obj);
     }
+    writer.end_object();
   });
 }
 #endif
@@ -380,16 +461,12 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
+  return json::write_json([this, obj, start_config](json::JsonWriter &writer) {
+    writer.begin_object();
+    this->write_json_id_(writer, obj, "button-" + obj->get_object_id(), start_config);
+    if (start_config == DETAIL_ALL)
+      this->write_json_sorting_(writer, obj);
+    writer.end_object();
   });
 }
 #endif
@@ -398,7 +475,11 @@ std::string WebServer::button_json(button::Button *obj, JsonDetail start_config)
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (this->events_.count() == 0)
     return;
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+  this->queue_compact_state_(obj, state, state ? "ON" : "OFF");
+#else
   this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+#endif
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
@@ -418,17 +499,14 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
   request->send(404);
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
-                              start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
+  return json::write_json([this, obj, value, start_config](json::JsonWriter &writer) {
+    writer.begin_object();
+    this->write_json_id_(writer, obj, "binary_sensor-" + obj->get_object_id(), start_config);
+    writer.add("value", value);
+    writer.add("state", value ? "ON" : "OFF");
+    if (start_config == DETAIL_ALL)
+      this->write_json_sorting_(writer, obj);
+    writer.end_object();
   });
 }
 #endif
@@ -2,6 +2,7 @@
 
 #include "list_entities.h"
 
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/web_server_base/web_server_base.h"
 #ifdef USE_WEBSERVER
 #include "esphome/core/component.h"
@@ -351,12 +352,31 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   void schedule_(std::function<void()> &&f);
+  /// Write the id of the entity, and its details with DETAIL_ALL.
+  void write_json_id_(json::JsonWriter &writer, EntityBase *obj, const std::string &id, JsonDetail start_config);
+  /// Write the sorting weight and group of the entity, if any.
+  void write_json_sorting_(json::JsonWriter &writer, EntityBase *obj);
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+  /** Queue a state update for the next "states" event.
+   *
+   * The event carries a JSON array with an `[index, value, state]` array per entity whose state changed. The index is
+   * the `idx` sent with the entity details when the client connects.
+   */
+  template<typename T> void queue_compact_state_(EntityBase *obj, T value, const std::string &state);
+  void flush_compact_states_();
+#endif
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
   ListEntitiesIterator entities_iterator_;
   std::map<EntityBase *, SortingComponents> sorting_entitys_;
   std::map<uint64_t, SortingGroup> sorting_groups_;
+#ifdef USE_WEBSERVER_COMPACT_EVENTS
+  /// Pending compact state update of the entities by entity index, and the order they changed in.
+  std::vector<std::string> compact_states_;
+  std::vector<uint16_t> compact_order_;
+  uint32_t last_compact_flush_{0};
+#endif
 
 #if USE_WEBSERVER_VERSION == 1
   const char *css_url_{nullptr};
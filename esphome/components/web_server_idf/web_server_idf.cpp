@@ -283,9 +283,59 @@ void AsyncEventSource::handleRequest(AsyncWebServerRequest *request) {
   this->sessions_.insert(rsp);
 }
 
+/// Format an event as a single HTTP chunk, which is written as is to every event stream.
+static std::string format_event_chunk(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
+  std::string ev;
+
+  if (reconnect) {
+    ev.append("retry: ", sizeof("retry: ") - 1);
+    ev.append(to_string(reconnect));
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (id) {
+    ev.append("id: ", sizeof("id: ") - 1);
+    ev.append(to_string(id));
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (event && *event) {
+    ev.append("event: ", sizeof("event: ") - 1);
+    ev.append(event);
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (message && *message) {
+    ev.append("data: ", sizeof("data: ") - 1);
+    ev.append(message);
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (ev.empty()) {
+    return ev;
+  }
+
+  ev.append(CRLF_STR, CRLF_LEN);
+
+  // Chunked content prelude, the content and the end of the chunk
+  std::string chunk = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
+  chunk.reserve(chunk.size() + ev.size() + CRLF_LEN);
+  chunk.append(ev);
+  chunk.append(CRLF_STR, CRLF_LEN);
+  return chunk;
+}
+
 void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
+  if (this->sessions_.empty()) {
+    return;
+  }
+  // Format the event once and share it between all sessions
+  std::string chunk = format_event_chunk(message, event, id, reconnect);
+  if (chunk.empty()) {
+    return;
+  }
   for (auto *ses : this->sessions_) {
-    ses->send(message, event, id, reconnect);
+    ses->send_chunk_(chunk);
   }
 }
 
@@ -321,48 +371,17 @@ void AsyncEventSourceResponse::send(const char *message, const char *event, uint
   if (this->fd_ == 0) {
     return;
   }
-
-  std::string ev;
-
-  if (reconnect) {
-    ev.append("retry: ", sizeof("retry: ") - 1);
-    ev.append(to_string(reconnect));
-    ev.append(CRLF_STR, CRLF_LEN);
-  }
-
-  if (id) {
-    ev.append("id: ", sizeof("id: ") - 1);
-    ev.append(to_string(id));
-    ev.append(CRLF_STR, CRLF_LEN);
-  }
-
-  if (event && *event) {
-    ev.append("event: ", sizeof("event: ") - 1);
-    ev.append(event);
-    ev.append(CRLF_STR, CRLF_LEN);
-  }
-
-  if (message && *message) {
-    ev.append("data: ", sizeof("data: ") - 1);
-    ev.append(message);
-    ev.append(CRLF_STR, CRLF_LEN);
+  std::string chunk = format_event_chunk(message, event, id, reconnect);
+  if (!chunk.empty()) {
+    this->send_chunk_(chunk);
   }
+}
 
-  if (ev.empty()) {
+void AsyncEventSourceResponse::send_chunk_(const std::string &chunk) {
+  if (this->fd_ == 0) {
     return;
   }
-
-  ev.append(CRLF_STR, CRLF_LEN);
-
-  // Sending chunked content prelude
-  auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
-  httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
-
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
-
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
+  httpd_socket_send(this->hd_, this->fd_, chunk.data(), chunk.size(), 0);
 }
 
 }  // namespace web_server_idf
@@ -225,6 +225,7 @@ class AsyncEventSourceResponse {
  protected:
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
   static void destroy(void *p);
+  void send_chunk_(const std::string &chunk);
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
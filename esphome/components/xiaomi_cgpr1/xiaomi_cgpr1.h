@@ -15,7 +15,10 @@ class XiaomiCGPR1 : public Component,
                     public binary_sensor::BinarySensorInitiallyOff,
                     public esp32_ble_tracker::ESPBTDeviceListener {
  public:
-  void set_address(uint64_t address) { address_ = address; }
+  void set_address(uint64_t address) {
+    address_ = address;
+    this->add_filter_address(address);
+  }
   void set_bindkey(const std::string &bindkey);
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
@@ -11,7 +11,10 @@ namespace xiaomi_hhccjcy10 {
 
 class XiaomiHHCCJCY10 : public Component, public esp32_ble_tracker::ESPBTDeviceListener {
  public:
-  void set_address(uint64_t address) { this->address_ = address; }
+  void set_address(uint64_t address) {
+    this->address_ = address;
+    this->add_filter_address(address);
+  }
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 
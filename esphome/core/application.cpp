@@ -2,6 +2,15 @@
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
+#include <algorithm>
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#ifdef USE_SOCKET_IMPL_LWIP_SOCKETS
+#include <lwip/sockets.h>
+#else
+#include <sys/select.h>
+#endif
+#endif
 
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
@@ -11,6 +20,9 @@ namespace esphome {
 
 static const char *const TAG = "app";
 
+/// Longest sleep at the end of loop() while every component loop is disabled, keeps the watchdog fed.
+static const uint32_t MAX_IDLE_SLEEP = 1000;
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +39,9 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#ifdef USE_ESP32
+  this->wake_semaphore_ = xSemaphoreCreateBinary();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -60,15 +75,89 @@ void Application::setup() {
   }
 
   ESP_LOGI(TAG, "setup() finished successfully!");
+  this->build_key_indexes_();
   this->schedule_dump_config();
   this->calculate_looping_components_();
 }
+void Application::build_key_indexes_() {
+#ifdef USE_BINARY_SENSOR
+  build_key_index_(this->binary_sensors_, this->binary_sensors_by_key_);
+#endif
+#ifdef USE_SWITCH
+  build_key_index_(this->switches_, this->switches_by_key_);
+#endif
+#ifdef USE_BUTTON
+  build_key_index_(this->buttons_, this->buttons_by_key_);
+#endif
+#ifdef USE_SENSOR
+  build_key_index_(this->sensors_, this->sensors_by_key_);
+#endif
+#ifdef USE_TEXT_SENSOR
+  build_key_index_(this->text_sensors_, this->text_sensors_by_key_);
+#endif
+#ifdef USE_FAN
+  build_key_index_(this->fans_, this->fans_by_key_);
+#endif
+#ifdef USE_COVER
+  build_key_index_(this->covers_, this->covers_by_key_);
+#endif
+#ifdef USE_LIGHT
+  build_key_index_(this->lights_, this->lights_by_key_);
+#endif
+#ifdef USE_CLIMATE
+  build_key_index_(this->climates_, this->climates_by_key_);
+#endif
+#ifdef USE_NUMBER
+  build_key_index_(this->numbers_, this->numbers_by_key_);
+#endif
+#ifdef USE_DATETIME_DATE
+  build_key_index_(this->dates_, this->dates_by_key_);
+#endif
+#ifdef USE_DATETIME_TIME
+  build_key_index_(this->times_, this->times_by_key_);
+#endif
+#ifdef USE_DATETIME_DATETIME
+  build_key_index_(this->datetimes_, this->datetimes_by_key_);
+#endif
+#ifdef USE_TEXT
+  build_key_index_(this->texts_, this->texts_by_key_);
+#endif
+#ifdef USE_SELECT
+  build_key_index_(this->selects_, this->selects_by_key_);
+#endif
+#ifdef USE_LOCK
+  build_key_index_(this->locks_, this->locks_by_key_);
+#endif
+#ifdef USE_VALVE
+  build_key_index_(this->valves_, this->valves_by_key_);
+#endif
+#ifdef USE_MEDIA_PLAYER
+  build_key_index_(this->media_players_, this->media_players_by_key_);
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  build_key_index_(this->alarm_control_panels_, this->alarm_control_panels_by_key_);
+#endif
+#ifdef USE_EVENT
+  build_key_index_(this->events_, this->events_by_key_);
+#endif
+#ifdef USE_UPDATE
+  build_key_index_(this->updates_, this->updates_by_key_);
+#endif
+}
 void Application::loop() {
   uint32_t new_app_state = 0;
 
+  if (this->has_pending_enable_loop_requests_)
+    this->process_pending_enable_loop_requests_();
+
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+  // Components may disable/enable their own (or other components') loop from loop(), which moves entries in
+  // looping_components_. disable_component_loop_() keeps current_loop_index_ pointing at the right spot.
+  this->in_loop_ = true;
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
     {
       WarnIfComponentBlockingGuard guard{component};
       component->call();
@@ -77,22 +166,19 @@ void Application::loop() {
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+  this->in_loop_ = false;
   this->app_state_ = new_app_state;
 
   const uint32_t now = millis();
 
-  auto elapsed = now - this->last_loop_;
-  if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
-    yield();
-  } else {
-    uint32_t delay_time = this->loop_interval_ - elapsed;
-    uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
-    // next_schedule is max 0.5*delay_time
-    // otherwise interval=0 schedules result in constant looping with almost no sleep
-    next_schedule = std::max(next_schedule, delay_time / 2);
-    delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
-  }
+  const uint32_t delay_time = this->calculate_sleep_time_(now);
+#ifdef USE_RUNTIME_STATS
+  const uint32_t idle_start = micros();
+  this->sleep_(delay_time);
+  this->idle_time_us_ += micros() - idle_start;
+#else
+  this->sleep_(delay_time);
+#endif
   this->last_loop_ = now;
 
   if (this->dump_config_at_ < this->components_.size()) {
@@ -144,12 +230,163 @@ void Application::run_safe_shutdown_hooks() {
 }
 
 void Application::calculate_looping_components_() {
+  // Active components first, then those that already disabled their loop during setup
+  for (auto *obj : this->components_) {
+    if (obj->has_overridden_loop() && !obj->is_loop_disabled())
+      this->looping_components_.push_back(obj);
+  }
+  this->looping_components_active_end_ = this->looping_components_.size();
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
+    if (obj->has_overridden_loop() && obj->is_loop_disabled())
       this->looping_components_.push_back(obj);
   }
 }
 
+void Application::disable_component_loop_(Component *component) {
+  for (size_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Rotate instead of swap so the remaining active components keep their order
+    std::rotate(this->looping_components_.begin() + i, this->looping_components_.begin() + i + 1,
+                this->looping_components_.begin() + this->looping_components_active_end_);
+    this->looping_components_active_end_--;
+    // Everything after i moved down by one, so make sure loop() doesn't skip the next component
+    if (this->in_loop_ && i <= this->current_loop_index_)
+      this->current_loop_index_--;
+    return;
+  }
+}
+
+void Application::enable_component_loop_(Component *component) {
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    std::rotate(this->looping_components_.begin() + this->looping_components_active_end_,
+                this->looping_components_.begin() + i, this->looping_components_.begin() + i + 1);
+    this->looping_components_active_end_++;
+    return;
+  }
+}
+
+uint32_t Application::calculate_sleep_time_(uint32_t now) {
+  if (this->has_pending_enable_loop_requests_ || HighFrequencyLoopRequester::is_high_frequency())
+    return 0;
+
+  // sleep_() waits on either the wake sockets or the semaphore, never both, so only idle for long when the
+  // primitive it will actually block on is the only wake source
+  bool has_semaphore = false;
+#ifdef USE_ESP32
+  has_semaphore = this->wake_semaphore_ != nullptr;
+#endif
+  bool has_sockets = false;
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  has_sockets = !this->socket_wakes_.empty();
+#endif
+  const bool can_wake = has_semaphore != has_sockets;
+  if (this->looping_components_active_end_ == 0 && can_wake) {
+    // nothing to dispatch until the next scheduler item is due or a wake source fires
+    return std::min(this->scheduler.next_schedule_in().value_or(MAX_IDLE_SLEEP), MAX_IDLE_SLEEP);
+  }
+
+  const uint32_t elapsed = now - this->last_loop_;
+  if (elapsed >= this->loop_interval_)
+    return 0;
+  uint32_t delay_time = this->loop_interval_ - elapsed;
+  uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
+  // next_schedule is max 0.5*delay_time
+  // otherwise interval=0 schedules result in constant looping with almost no sleep
+  next_schedule = std::max(next_schedule, delay_time / 2);
+  return std::min(next_schedule, delay_time);
+}
+
+void Application::sleep_(uint32_t delay_ms) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (!this->socket_wakes_.empty()) {
+    // also polls the sockets when not sleeping, so disabled components still get woken
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    int max_fd = -1;
+    for (auto &wake : this->socket_wakes_) {
+      FD_SET(wake.first, &read_fds);
+      max_fd = std::max(max_fd, wake.first);
+    }
+    struct timeval tv;
+    tv.tv_sec = delay_ms / 1000;
+    tv.tv_usec = (delay_ms % 1000) * 1000;
+#ifdef USE_SOCKET_IMPL_LWIP_SOCKETS
+    const int ready = lwip_select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+#else
+    const int ready = ::select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+#endif
+    if (ready > 0) {
+      for (auto &wake : this->socket_wakes_) {
+        if (FD_ISSET(wake.first, &read_fds))
+          wake.second->enable_loop();
+      }
+    }
+    if (delay_ms == 0)
+      yield();
+    return;
+  }
+#endif
+  if (delay_ms == 0) {
+    yield();
+    return;
+  }
+#ifdef USE_ESP32
+  if (this->wake_semaphore_ != nullptr) {
+    xSemaphoreTake(this->wake_semaphore_, pdMS_TO_TICKS(delay_ms));
+    return;
+  }
+#endif
+  delay(delay_ms);
+}
+
+void IRAM_ATTR Application::wake_loop_any_context() {
+#ifdef USE_ESP32
+  if (this->wake_semaphore_ == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(this->wake_semaphore_, &woken);
+    if (woken == pdTRUE)
+      portYIELD_FROM_ISR();
+  } else {
+    xSemaphoreGive(this->wake_semaphore_);
+  }
+#endif
+}
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+void Application::register_socket_wake(int fd, Component *component) {
+  if (fd < 0)
+    return;
+  this->unregister_socket_wake(fd);
+  this->socket_wakes_.emplace_back(fd, component);
+}
+
+void Application::unregister_socket_wake(int fd) {
+  for (auto it = this->socket_wakes_.begin(); it != this->socket_wakes_.end(); ++it) {
+    if (it->first == fd) {
+      this->socket_wakes_.erase(it);
+      return;
+    }
+  }
+}
+#endif
+
+void Application::process_pending_enable_loop_requests_() {
+  // Clear first so a request arriving while we iterate is handled on the next iteration
+  this->has_pending_enable_loop_requests_ = false;
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    Component *component = this->looping_components_[i];
+    if (!component->pending_enable_loop_)
+      continue;
+    component->pending_enable_loop_ = false;
+    component->enable_loop();
+  }
+}
+
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 }  // namespace esphome
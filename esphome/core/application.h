@@ -1,14 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -99,90 +106,149 @@ class Application {
 
 #ifdef USE_BINARY_SENSOR
   void register_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
+    this->register_entity_(binary_sensor);
     this->binary_sensors_.push_back(binary_sensor);
   }
 #endif
 
 #ifdef USE_SENSOR
-  void register_sensor(sensor::Sensor *sensor) { this->sensors_.push_back(sensor); }
+  void register_sensor(sensor::Sensor *sensor) {
+    this->register_entity_(sensor);
+    this->sensors_.push_back(sensor);
+  }
 #endif
 
 #ifdef USE_SWITCH
-  void register_switch(switch_::Switch *a_switch) { this->switches_.push_back(a_switch); }
+  void register_switch(switch_::Switch *a_switch) {
+    this->register_entity_(a_switch);
+    this->switches_.push_back(a_switch);
+  }
 #endif
 
 #ifdef USE_BUTTON
-  void register_button(button::Button *button) { this->buttons_.push_back(button); }
+  void register_button(button::Button *button) {
+    this->register_entity_(button);
+    this->buttons_.push_back(button);
+  }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  void register_text_sensor(text_sensor::TextSensor *sensor) { this->text_sensors_.push_back(sensor); }
+  void register_text_sensor(text_sensor::TextSensor *sensor) {
+    this->register_entity_(sensor);
+    this->text_sensors_.push_back(sensor);
+  }
 #endif
 
 #ifdef USE_FAN
-  void register_fan(fan::Fan *state) { this->fans_.push_back(state); }
+  void register_fan(fan::Fan *state) {
+    this->register_entity_(state);
+    this->fans_.push_back(state);
+  }
 #endif
 
 #ifdef USE_COVER
-  void register_cover(cover::Cover *cover) { this->covers_.push_back(cover); }
+  void register_cover(cover::Cover *cover) {
+    this->register_entity_(cover);
+    this->covers_.push_back(cover);
+  }
 #endif
 
 #ifdef USE_CLIMATE
-  void register_climate(climate::Climate *climate) { this->climates_.push_back(climate); }
+  void register_climate(climate::Climate *climate) {
+    this->register_entity_(climate);
+    this->climates_.push_back(climate);
+  }
 #endif
 
 #ifdef USE_LIGHT
-  void register_light(light::LightState *light) { this->lights_.push_back(light); }
+  void register_light(light::LightState *light) {
+    this->register_entity_(light);
+    this->lights_.push_back(light);
+  }
 #endif
 
 #ifdef USE_NUMBER
-  void register_number(number::Number *number) { this->numbers_.push_back(number); }
+  void register_number(number::Number *number) {
+    this->register_entity_(number);
+    this->numbers_.push_back(number);
+  }
 #endif
 
 #ifdef USE_DATETIME_DATE
-  void register_date(datetime::DateEntity *date) { this->dates_.push_back(date); }
+  void register_date(datetime::DateEntity *date) {
+    this->register_entity_(date);
+    this->dates_.push_back(date);
+  }
 #endif
 
 #ifdef USE_DATETIME_TIME
-  void register_time(datetime::TimeEntity *time) { this->times_.push_back(time); }
+  void register_time(datetime::TimeEntity *time) {
+    this->register_entity_(time);
+    this->times_.push_back(time);
+  }
 #endif
 
 #ifdef USE_DATETIME_DATETIME
-  void register_datetime(datetime::DateTimeEntity *datetime) { this->datetimes_.push_back(datetime); }
+  void register_datetime(datetime::DateTimeEntity *datetime) {
+    this->register_entity_(datetime);
+    this->datetimes_.push_back(datetime);
+  }
 #endif
 
 #ifdef USE_TEXT
-  void register_text(text::Text *text) { this->texts_.push_back(text); }
+  void register_text(text::Text *text) {
+    this->register_entity_(text);
+    this->texts_.push_back(text);
+  }
 #endif
 
 #ifdef USE_SELECT
-  void register_select(select::Select *select) { this->selects_.push_back(select); }
+  void register_select(select::Select *select) {
+    this->register_entity_(select);
+    this->selects_.push_back(select);
+  }
 #endif
 
 #ifdef USE_LOCK
-  void register_lock(lock::Lock *a_lock) { this->locks_.push_back(a_lock); }
+  void register_lock(lock::Lock *a_lock) {
+    this->register_entity_(a_lock);
+    this->locks_.push_back(a_lock);
+  }
 #endif
 
 #ifdef USE_VALVE
-  void register_valve(valve::Valve *valve) { this->valves_.push_back(valve); }
+  void register_valve(valve::Valve *valve) {
+    this->register_entity_(valve);
+    this->valves_.push_back(valve);
+  }
 #endif
 
 #ifdef USE_MEDIA_PLAYER
-  void register_media_player(media_player::MediaPlayer *media_player) { this->media_players_.push_back(media_player); }
+  void register_media_player(media_player::MediaPlayer *media_player) {
+    this->register_entity_(media_player);
+    this->media_players_.push_back(media_player);
+  }
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
   void register_alarm_control_panel(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
+    this->register_entity_(a_alarm_control_panel);
     this->alarm_control_panels_.push_back(a_alarm_control_panel);
   }
 #endif
 
 #ifdef USE_EVENT
-  void register_event(event::Event *event) { this->events_.push_back(event); }
+  void register_event(event::Event *event) {
+    this->register_entity_(event);
+    this->events_.push_back(event);
+  }
 #endif
 
 #ifdef USE_UPDATE
-  void register_update(update::UpdateEntity *update) { this->updates_.push_back(update); }
+  void register_update(update::UpdateEntity *update) {
+    this->register_entity_(update);
+    this->updates_.push_back(update);
+  }
 #endif
 
   /// Register the component in this Application instance.
@@ -201,6 +267,9 @@ class Application {
   /// Get the name of this Application set by pre_setup().
   const std::string &get_name() const { return this->name_; }
 
+  /// Get the number of registered entities, every entity has an index below this, see EntityBase::get_entity_index().
+  uint16_t get_entity_count() const { return this->entity_count_; }
+
   /// Get the friendly name of this Application set by pre_setup().
   const std::string &get_friendly_name() const { return this->friendly_name_; }
 
@@ -231,6 +300,24 @@ class Application {
 
   uint32_t get_loop_interval() const { return this->loop_interval_; }
 
+  /** Cut the sleep at the end of loop() short, so requests from Component::enable_loop_soon_any_context() are handled
+   * right away. Safe to call from any context, including interrupt handlers.
+   *
+   * Only ESP32 can be woken this way, and not while loop() waits on sockets registered with register_socket_wake().
+   * Elsewhere the request is handled once the sleep ends.
+   */
+  void wake_loop_any_context();
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /** Enable the loop of `component` when `fd` becomes readable.
+   *
+   * The sleep at the end of loop() waits on the registered sockets, so a component whose loop only handles incoming
+   * data can disable its loop and rely on this to be woken.
+   */
+  void register_socket_wake(int fd, Component *component);
+  void unregister_socket_wake(int fd);
+#endif
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -243,184 +330,119 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
+#ifdef USE_RUNTIME_STATS
+  /// Total time spent sleeping in delay() at the end of loop() since boot, in microseconds.
+  uint64_t get_idle_time_us() const { return this->idle_time_us_; }
+#endif
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->binary_sensors_, this->binary_sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->switches_, this->switches_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->buttons_, this->buttons_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->sensors_, this->sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->text_sensors_, this->text_sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::Fan *> &get_fans() { return this->fans_; }
   fan::Fan *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->fans_, this->fans_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->covers_, this->covers_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->lights_, this->lights_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->climates_, this->climates_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->numbers_, this->numbers_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_DATE
   const std::vector<datetime::DateEntity *> &get_dates() { return this->dates_; }
   datetime::DateEntity *get_date_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->dates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->dates_, this->dates_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_TIME
   const std::vector<datetime::TimeEntity *> &get_times() { return this->times_; }
   datetime::TimeEntity *get_time_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->times_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->times_, this->times_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_DATETIME
   const std::vector<datetime::DateTimeEntity *> &get_datetimes() { return this->datetimes_; }
   datetime::DateTimeEntity *get_datetime_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->datetimes_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->datetimes_, this->datetimes_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT
   const std::vector<text::Text *> &get_texts() { return this->texts_; }
   text::Text *get_text_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->texts_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->texts_, this->texts_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->selects_, this->selects_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_LOCK
   const std::vector<lock::Lock *> &get_locks() { return this->locks_; }
   lock::Lock *get_lock_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->locks_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->locks_, this->locks_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_VALVE
   const std::vector<valve::Valve *> &get_valves() { return this->valves_; }
   valve::Valve *get_valve_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->valves_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->valves_, this->valves_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_MEDIA_PLAYER
   const std::vector<media_player::MediaPlayer *> &get_media_players() { return this->media_players_; }
   media_player::MediaPlayer *get_media_player_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->media_players_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->media_players_, this->media_players_by_key_, key, include_internal);
   }
 #endif
 
@@ -429,33 +451,21 @@ class Application {
     return this->alarm_control_panels_;
   }
   alarm_control_panel::AlarmControlPanel *get_alarm_control_panel_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->alarm_control_panels_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->alarm_control_panels_, this->alarm_control_panels_by_key_, key, include_internal);
   }
 #endif
 
 #ifdef USE_EVENT
   const std::vector<event::Event *> &get_events() { return this->events_; }
   event::Event *get_event_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->events_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->events_, this->events_by_key_, key, include_internal);
   }
 #endif
 
 #ifdef USE_UPDATE
   const std::vector<update::UpdateEntity *> &get_updates() { return this->updates_; }
   update::UpdateEntity *get_update_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->updates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_by_key_(this->updates_, this->updates_by_key_, key, include_internal);
   }
 #endif
 
@@ -465,76 +475,151 @@ class Application {
   friend Component;
 
   void register_component_(Component *comp);
+  void register_entity_(EntityBase *entity) { entity->set_entity_index(this->entity_count_++); }
+
+  /// Build the key indexes used by the get_*_by_key() lookups, once all entities are registered.
+  void build_key_indexes_();
+  template<typename T> static void build_key_index_(const std::vector<T *> &entities, std::vector<T *> &index) {
+    index = entities;
+    std::stable_sort(index.begin(), index.end(),
+                     [](T *a, T *b) { return a->get_object_id_hash() < b->get_object_id_hash(); });
+  }
+  /// Binary search for an entity by key, falls back to a linear scan while the index is not built.
+  template<typename T>
+  static T *find_by_key_(const std::vector<T *> &entities, const std::vector<T *> &index, uint32_t key,
+                         bool include_internal) {
+    if (index.size() != entities.size()) {
+      for (auto *obj : entities) {
+        if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
+          return obj;
+      }
+      return nullptr;
+    }
+    auto it = std::lower_bound(index.begin(), index.end(), key,
+                               [](T *obj, uint32_t value) { return obj->get_object_id_hash() < value; });
+    for (; it != index.end() && (*it)->get_object_id_hash() == key; it++) {
+      if (include_internal || !(*it)->is_internal())
+        return *it;
+    }
+    return nullptr;
+  }
 
   void calculate_looping_components_();
 
+  /// Move a component out of the active part of `looping_components_`, see Component::disable_loop().
+  void disable_component_loop_(Component *component);
+  /// Move a component back into the active part of `looping_components_`, see Component::enable_loop().
+  void enable_component_loop_(Component *component);
+  /// Handle Component::enable_loop_soon_any_context() requests.
+  void process_pending_enable_loop_requests_();
+  /// How long to sleep at the end of loop(), 0 to only yield.
+  uint32_t calculate_sleep_time_(uint32_t now);
+  /// Sleep for up to `delay_ms`, returning early when a wake source fires.
+  void sleep_(uint32_t delay_ms);
+
   void feed_wdt_arch_();
 
   std::vector<Component *> components_{};
+  /// Components with an overridden loop(). Only the first `looping_components_active_end_` have their loop enabled.
   std::vector<Component *> looping_components_{};
+  size_t looping_components_active_end_{0};
+  /// Index into `looping_components_` of the component whose loop() is currently running.
+  size_t current_loop_index_{0};
+  bool in_loop_{false};
+  volatile bool has_pending_enable_loop_requests_{false};
+  uint16_t entity_count_{0};
+#ifdef USE_ESP32
+  /// Given by wake_loop_any_context(), the sleep at the end of loop() waits on it.
+  SemaphoreHandle_t wake_semaphore_{nullptr};
+#endif
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /// Sockets whose component loop is enabled when they become readable, as (fd, component).
+  std::vector<std::pair<int, Component *>> socket_wakes_{};
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
+  std::vector<binary_sensor::BinarySensor *> binary_sensors_by_key_{};
 #endif
 #ifdef USE_SWITCH
   std::vector<switch_::Switch *> switches_{};
+  std::vector<switch_::Switch *> switches_by_key_{};
 #endif
 #ifdef USE_BUTTON
   std::vector<button::Button *> buttons_{};
+  std::vector<button::Button *> buttons_by_key_{};
 #endif
 #ifdef USE_EVENT
   std::vector<event::Event *> events_{};
+  std::vector<event::Event *> events_by_key_{};
 #endif
 #ifdef USE_SENSOR
   std::vector<sensor::Sensor *> sensors_{};
+  std::vector<sensor::Sensor *> sensors_by_key_{};
 #endif
 #ifdef USE_TEXT_SENSOR
   std::vector<text_sensor::TextSensor *> text_sensors_{};
+  std::vector<text_sensor::TextSensor *> text_sensors_by_key_{};
 #endif
 #ifdef USE_FAN
   std::vector<fan::Fan *> fans_{};
+  std::vector<fan::Fan *> fans_by_key_{};
 #endif
 #ifdef USE_COVER
   std::vector<cover::Cover *> covers_{};
+  std::vector<cover::Cover *> covers_by_key_{};
 #endif
 #ifdef USE_CLIMATE
   std::vector<climate::Climate *> climates_{};
+  std::vector<climate::Climate *> climates_by_key_{};
 #endif
 #ifdef USE_LIGHT
   std::vector<light::LightState *> lights_{};
+  std::vector<light::LightState *> lights_by_key_{};
 #endif
 #ifdef USE_NUMBER
   std::vector<number::Number *> numbers_{};
+  std::vector<number::Number *> numbers_by_key_{};
 #endif
 #ifdef USE_DATETIME_DATE
   std::vector<datetime::DateEntity *> dates_{};
+  std::vector<datetime::DateEntity *> dates_by_key_{};
 #endif
 #ifdef USE_DATETIME_TIME
   std::vector<datetime::TimeEntity *> times_{};
+  std::vector<datetime::TimeEntity *> times_by_key_{};
 #endif
 #ifdef USE_DATETIME_DATETIME
   std::vector<datetime::DateTimeEntity *> datetimes_{};
+  std::vector<datetime::DateTimeEntity *> datetimes_by_key_{};
 #endif
 #ifdef USE_SELECT
   std::vector<select::Select *> selects_{};
+  std::vector<select::Select *> selects_by_key_{};
 #endif
 #ifdef USE_TEXT
   std::vector<text::Text *> texts_{};
+  std::vector<text::Text *> texts_by_key_{};
 #endif
 #ifdef USE_LOCK
   std::vector<lock::Lock *> locks_{};
+  std::vector<lock::Lock *> locks_by_key_{};
 #endif
 #ifdef USE_VALVE
   std::vector<valve::Valve *> valves_{};
+  std::vector<valve::Valve *> valves_by_key_{};
 #endif
 #ifdef USE_MEDIA_PLAYER
   std::vector<media_player::MediaPlayer *> media_players_{};
+  std::vector<media_player::MediaPlayer *> media_players_by_key_{};
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   std::vector<alarm_control_panel::AlarmControlPanel *> alarm_control_panels_{};
+  std::vector<alarm_control_panel::AlarmControlPanel *> alarm_control_panels_by_key_{};
 #endif
 #ifdef USE_UPDATE
   std::vector<update::UpdateEntity *> updates_{};
+  std::vector<update::UpdateEntity *> updates_by_key_{};
 #endif
 
   std::string name_;
@@ -547,6 +632,9 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+#ifdef USE_RUNTIME_STATS
+  uint64_t idle_time_us_{0};
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -325,7 +325,7 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
 
     if (this->timeout_value_.has_value()) {
       auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
+      this->set_timeout_literal("timeout", this->timeout_value_.value(x...), f);
     }
 
     this->loop();
@@ -34,6 +34,7 @@ const uint32_t COMPONENT_STATE_CONSTRUCTION = 0x00;
 const uint32_t COMPONENT_STATE_SETUP = 0x01;
 const uint32_t COMPONENT_STATE_LOOP = 0x02;
 const uint32_t COMPONENT_STATE_FAILED = 0x03;
+const uint32_t COMPONENT_STATE_LOOP_DONE = 0x04;
 const uint32_t STATUS_LED_MASK = 0xFF00;
 const uint32_t STATUS_LED_OK = 0x0000;
 const uint32_t STATUS_LED_WARNING = 0x0100;
@@ -53,10 +54,18 @@ void Component::set_interval(const std::string &name, uint32_t interval, std::fu
   App.scheduler.set_interval(this, name, interval, std::move(f));
 }
 
+void Component::set_interval_literal(const char *name, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval_literal(this, name, interval, std::move(f));
+}
+
 bool Component::cancel_interval(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_interval(this, name);
 }
 
+bool Component::cancel_interval(const char *name) {  // NOLINT
+  return App.scheduler.cancel_interval(this, name);
+}
+
 void Component::set_retry(const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                           std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor) {  // NOLINT
   App.scheduler.set_retry(this, name, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
@@ -70,10 +79,18 @@ void Component::set_timeout(const std::string &name, uint32_t timeout, std::func
   return App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
 
+void Component::set_timeout_literal(const char *name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout_literal(this, name, timeout, std::move(f));
+}
+
 bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+bool Component::cancel_timeout(const char *name) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name);
+}
+
 void Component::call_loop() { this->loop(); }
 void Component::call_setup() { this->setup(); }
 void Component::call_dump_config() {
@@ -106,6 +123,9 @@ void Component::call() {
     case COMPONENT_STATE_FAILED:  // NOLINT(bugprone-branch-clone)
       // State failed: Do nothing
       break;
+    case COMPONENT_STATE_LOOP_DONE:  // NOLINT(bugprone-branch-clone)
+      // State loop done: loop() was disabled by the component, do nothing until it is enabled again
+      break;
     default:
       break;
   }
@@ -122,19 +142,25 @@ void Component::mark_failed() {
   this->status_set_error();
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", 0, std::move(f));
+  App.scheduler.set_timeout_literal(this, "", 0, std::move(f));
 }
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
+bool Component::cancel_defer(const char *name) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name);
+}
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
+void Component::defer_literal(const char *name, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout_literal(this, name, 0, std::move(f));
+}
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+  App.scheduler.set_timeout_literal(this, "", timeout, std::move(f));
 }
 void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, "", interval, std::move(f));
+  App.scheduler.set_interval_literal(this, "", interval, std::move(f));
 }
 void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,
                           float backoff_increase_factor) {  // NOLINT
@@ -143,8 +169,36 @@ void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std:
 bool Component::is_failed() const { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::is_ready() const {
   return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP ||
+         (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE ||
          (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_SETUP;
 }
+bool Component::is_loop_disabled() const {
+  return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE;
+}
+void Component::disable_loop() {
+  uint32_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  // before setup() the state must stay CONSTRUCTION, otherwise call() would never run setup()
+  if (state == COMPONENT_STATE_CONSTRUCTION || state == COMPONENT_STATE_LOOP_DONE || state == COMPONENT_STATE_FAILED)
+    return;
+  ESP_LOGVV(TAG, "Component %s loop disabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP_DONE;
+  App.disable_component_loop_(this);
+}
+void Component::enable_loop() {
+  if (!this->is_loop_disabled())
+    return;
+  ESP_LOGVV(TAG, "Component %s loop enabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP;
+  App.enable_component_loop_(this);
+}
+void IRAM_ATTR HOT Component::enable_loop_soon_any_context() {
+  // Only set flags here, the main loop picks them up and calls enable_loop() from the loop task
+  this->pending_enable_loop_ = true;
+  App.has_pending_enable_loop_requests_ = true;
+  App.wake_loop_any_context();
+}
 bool Component::can_proceed() { return true; }
 bool Component::status_has_warning() const { return this->component_state_ & STATUS_LED_WARNING; }
 bool Component::status_has_error() const { return this->component_state_ & STATUS_LED_ERROR; }
@@ -217,7 +271,7 @@ void PollingComponent::call_setup() {
 
 void PollingComponent::start_poller() {
   // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+  this->set_interval_literal("update", this->get_update_interval(), [this]() { this->update(); });
 }
 
 void PollingComponent::stop_poller() {
@@ -228,9 +282,23 @@ void PollingComponent::stop_poller() {
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
-WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component)
-    : started_(millis()), component_(component) {}
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, bool from_scheduler)
+    : started_(millis()), component_(component), from_scheduler_(from_scheduler) {
+#ifdef USE_RUNTIME_STATS
+  this->started_us_ = micros();
+#endif
+}
 WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
+#ifdef USE_RUNTIME_STATS
+  if (this->component_ != nullptr) {
+    const uint32_t duration_us = micros() - this->started_us_;
+    if (this->from_scheduler_) {
+      this->component_->get_runtime_stats().record_scheduler(duration_us);
+    } else {
+      this->component_->get_runtime_stats().record_loop(duration_us);
+    }
+  }
+#endif
   uint32_t now = millis();
   if (now - started_ > 50) {
     const char *src = component_ == nullptr ? "<null>" : component_->get_component_source();
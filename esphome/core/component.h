@@ -5,6 +5,7 @@
 #include <functional>
 #include <string>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -58,6 +59,7 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_STATE_LOOP_DONE;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -65,6 +67,32 @@ extern const uint32_t STATUS_LED_ERROR;
 
 enum class RetryResult { DONE, RETRY };
 
+#ifdef USE_RUNTIME_STATS
+/// Cumulative time a component spent in loop() and in its scheduler callbacks, in microseconds.
+struct ComponentRuntimeStats {
+  uint32_t loop_count{0};
+  uint32_t loop_max_us{0};
+  uint64_t loop_time_us{0};
+  uint32_t scheduler_count{0};
+  uint32_t scheduler_max_us{0};
+  uint64_t scheduler_time_us{0};
+
+  void record_loop(uint32_t duration_us) {
+    this->loop_count++;
+    this->loop_time_us += duration_us;
+    if (duration_us > this->loop_max_us)
+      this->loop_max_us = duration_us;
+  }
+  void record_scheduler(uint32_t duration_us) {
+    this->scheduler_count++;
+    this->scheduler_time_us += duration_us;
+    if (duration_us > this->scheduler_max_us)
+      this->scheduler_max_us = duration_us;
+  }
+  uint64_t total_time_us() const { return this->loop_time_us + this->scheduler_time_us; }
+};
+#endif
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -142,6 +170,30 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Components that only have work to do when something happens can call this from setup() or loop() once they are
+   * idle, so Application::loop() doesn't have to dispatch to them on every iteration. They are woken by:
+   * - a scheduler callback of the component calling enable_loop(), those keep running while the loop is disabled
+   * - an interrupt handler or another task calling enable_loop_soon_any_context()
+   * - data on a socket registered with Application::register_socket_wake()
+   *
+   * Has no effect before setup() has run.
+   */
+  void disable_loop();
+
+  /// Resume calling loop() for this component after disable_loop(). Must be called from the main loop task.
+  void enable_loop();
+
+  /** Resume calling loop() for this component at the start of the next main loop iteration.
+   *
+   * Unlike enable_loop(), this is safe to call from any context, including interrupt handlers and other tasks.
+   */
+  void enable_loop_soon_any_context();
+
+  /// Whether loop() is currently disabled via disable_loop().
+  bool is_loop_disabled() const;
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -153,6 +205,12 @@ class Component {
    */
   const char *get_component_source() const;
 
+#ifdef USE_RUNTIME_STATS
+  /// Time spent in this component's loop() and scheduler callbacks since boot.
+  const ComponentRuntimeStats &get_runtime_stats() const { return this->runtime_stats_; }
+  ComponentRuntimeStats &get_runtime_stats() { return this->runtime_stats_; }
+#endif
+
  protected:
   friend class Application;
 
@@ -177,6 +235,21 @@ class Component {
    */
   void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /// Set an interval function with a name in a char array, which is copied like with the std::string variant.
+  template<size_t N> void set_interval(const char (&name)[N], uint32_t interval, std::function<void()> &&f) {  // NOLINT
+    this->set_interval(std::string(name), interval, std::move(f));
+  }
+  template<size_t N> void set_interval(char (&name)[N], uint32_t interval, std::function<void()> &&f) {  // NOLINT
+    this->set_interval(std::string(name), interval, std::move(f));
+  }
+
+  /** Set an interval function with a name that is a string literal.
+   *
+   * Unlike set_interval(), the name is stored by pointer without copying, so it must outlive the interval. Only
+   * pass string literals.
+   */
+  void set_interval_literal(const char *name, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
   /** Cancel an interval function.
@@ -185,6 +258,7 @@ class Component {
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(const char *name);         // NOLINT
 
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
@@ -245,6 +319,21 @@ class Component {
    */
   void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /// Set a timeout function with a name in a char array, which is copied like with the std::string variant.
+  template<size_t N> void set_timeout(const char (&name)[N], uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+    this->set_timeout(std::string(name), timeout, std::move(f));
+  }
+  template<size_t N> void set_timeout(char (&name)[N], uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+    this->set_timeout(std::string(name), timeout, std::move(f));
+  }
+
+  /** Set a timeout function with a name that is a string literal.
+   *
+   * Unlike set_timeout(), the name is stored by pointer without copying, so it must outlive the timeout. Only
+   * pass string literals.
+   */
+  void set_timeout_literal(const char *name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
   /** Cancel a timeout function.
@@ -253,6 +342,7 @@ class Component {
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(const char *name);         // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -263,15 +353,31 @@ class Component {
    */
   void defer(const std::string &name, std::function<void()> &&f);  // NOLINT
 
+  /// Defer a callback to the next loop() call, with a name in a char array that is copied.
+  template<size_t N> void defer(const char (&name)[N], std::function<void()> &&f) {  // NOLINT
+    this->defer(std::string(name), std::move(f));
+  }
+  template<size_t N> void defer(char (&name)[N], std::function<void()> &&f) {  // NOLINT
+    this->defer(std::string(name), std::move(f));
+  }
+  /// Defer a callback to the next loop() call, with a name that is a string literal (stored without copying).
+  void defer_literal(const char *name, std::function<void()> &&f);  // NOLINT
+
   /// Defer a callback to the next loop() call.
   void defer(std::function<void()> &&f);  // NOLINT
 
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
+  bool cancel_defer(const char *name);         // NOLINT
 
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+  /// Set by enable_loop_soon_any_context(), handled by the main loop.
+  volatile bool pending_enable_loop_{false};
+#ifdef USE_RUNTIME_STATS
+  ComponentRuntimeStats runtime_stats_{};
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -321,12 +427,21 @@ class PollingComponent : public Component {
 
 class WarnIfComponentBlockingGuard {
  public:
-  WarnIfComponentBlockingGuard(Component *component);
+  /** Warn if the guarded operation of \p component blocks for too long.
+   *
+   * With runtime stats enabled, the duration is also accounted to the component, as loop() time or as
+   * scheduler callback time depending on \p from_scheduler.
+   */
+  WarnIfComponentBlockingGuard(Component *component, bool from_scheduler = false);
   ~WarnIfComponentBlockingGuard();
 
  protected:
   uint32_t started_;
   Component *component_;
+  bool from_scheduler_;
+#ifdef USE_RUNTIME_STATS
+  uint32_t started_us_;
+#endif
 };
 
 }  // namespace esphome
@@ -20,6 +20,8 @@ class ComponentIterator {
  public:
   void begin(bool include_internal = false);
   void advance();
+  /// Whether the iteration has not been started or has reached the end.
+  bool completed() const { return this->state_ == IteratorState::NONE; }
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
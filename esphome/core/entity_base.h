@@ -47,6 +47,10 @@ class EntityBase {
   std::string get_icon() const;
   void set_icon(const char *icon);
 
+  // Get/set the position of this Entity among all entities registered with the Application.
+  uint16_t get_entity_index() const { return this->entity_index_; }
+  void set_entity_index(uint16_t entity_index) { this->entity_index_ = entity_index; }
+
  protected:
   /// The hash_base() function has been deprecated. It is kept in this
   /// class for now, to prevent external components from not compiling.
@@ -57,6 +61,7 @@ class EntityBase {
   const char *object_id_c_str_{nullptr};
   const char *icon_c_str_{nullptr};
   uint32_t object_id_hash_;
+  uint16_t entity_index_{0};
   bool has_own_name_{false};
   bool internal_{false};
   bool disabled_by_default_{false};
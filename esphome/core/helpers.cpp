@@ -188,6 +188,14 @@ uint32_t fnv1_hash(const std::string &str) {
   }
   return hash;
 }
+uint32_t fnv1_hash(const char *str) {
+  uint32_t hash = 2166136261UL;
+  for (; *str != '\0'; str++) {
+    hash *= 16777619UL;
+    hash ^= *str;
+  }
+  return hash;
+}
 
 #ifdef USE_ESP32
 uint32_t random_uint32() { return esp_random(); }
@@ -166,6 +166,8 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc = 0, uint16_t p
 
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
+/// Calculate a FNV-1 hash of a null-terminated \p str.
+uint32_t fnv1_hash(const char *str);
 
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
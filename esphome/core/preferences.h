@@ -46,6 +46,18 @@ class ESPPreferences {
    */
   virtual bool sync() = 0;
 
+  /**
+   * Commit pending writes to flash, but stop once about max_duration ms have been spent on it.
+   *
+   * Backends that can not split their writes commit everything at once, like sync().
+   *
+   * @return true if all pending writes were attempted, false if some are left for the next call.
+   */
+  virtual bool sync_partial(uint32_t max_duration) {
+    this->sync();
+    return true;
+  }
+
   /**
    * Forget all unsaved changes and re-initialize the permanent preferences storage.
    * Usually followed by a restart which moves the system to "factory" conditions
@@ -4,12 +4,14 @@
 #include "esphome/core/hal.h"
 #include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 namespace esphome {
 
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+static const size_t MAX_POOLED_ITEMS = 16;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -17,67 +19,81 @@ static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 // A note on locking: the `lock_` lock protects the `items_` and `to_add_` containers. It must be taken when writing to
 // them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the loop task,
 // iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
-// avoid the main thread modifying the list while it is being accessed.
+// avoid the main thread modifying the list while it is being accessed. The same lock also guards `item_pool_`.
+//
+// Items are matched for cancellation by component, type and a FNV-1 hash of their name; the name itself is only
+// compared when the hashes collide, so re-arming a named timeout doesn't need a string compare per scheduled item.
+// Names passed to the *_literal() setters are stored by pointer and must outlive the item (i.e. be string literals).
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> func) {
-  const uint32_t now = this->millis_();
-
-  if (!name.empty())
-    this->cancel_timeout(component, name);
-
-  if (timeout == SCHEDULER_DONT_RUN)
-    return;
-
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
-
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
-  item->timeout = timeout;
-  item->last_execution = now;
-  item->last_execution_major = this->millis_major_;
-  item->callback = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+  this->set_timer_(component, SchedulerItem::TIMEOUT, nullptr, &name, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout_literal(Component *component, const char *name, uint32_t timeout,
+                                        std::function<void()> func) {
+  this->set_timer_(component, SchedulerItem::TIMEOUT, name, nullptr, timeout, std::move(func));
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name.c_str(), SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const char *name) {
   return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> func) {
+  this->set_timer_(component, SchedulerItem::INTERVAL, nullptr, &name, interval, std::move(func));
+}
+void HOT Scheduler::set_interval_literal(Component *component, const char *name, uint32_t interval,
+                                         std::function<void()> func) {
+  this->set_timer_(component, SchedulerItem::INTERVAL, name, nullptr, interval, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name.c_str(), SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, const char *name) {
+  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+}
+void HOT Scheduler::set_timer_(Component *component, SchedulerItem::Type type, const char *static_name,
+                               const std::string *dynamic_name, uint32_t delay, std::function<void()> func) {
   const uint32_t now = this->millis_();
+  const char *name = static_name != nullptr ? static_name : dynamic_name->c_str();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (name[0] != '\0')
+    this->cancel_item_(component, name, type);
 
-  if (interval == SCHEDULER_DONT_RUN)
+  if (delay == SCHEDULER_DONT_RUN)
     return;
 
-  // only put offset in lower half
-  uint32_t offset = 0;
-  if (interval != 0)
-    offset = (random_uint32() % interval) / 2;
-
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
-
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->make_item_();
   item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
-  item->interval = interval;
-  item->last_execution = now - offset - interval;
+  item->static_name = static_name;
+  if (static_name == nullptr)
+    item->name = *dynamic_name;
+  item->name_hash = fnv1_hash(name);
+  item->type = type;
+  item->interval = delay;
+  item->last_execution = now;
   item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
+
+  if (type == SchedulerItem::INTERVAL) {
+    // only put offset in lower half
+    uint32_t offset = 0;
+    if (delay != 0)
+      offset = (random_uint32() % delay) / 2;
+
+    ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name, delay, offset);
+
+    item->last_execution = now - offset - delay;
+    if (item->last_execution > now)
+      item->last_execution_major--;
+  } else {
+    ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name, delay);
+  }
+
   item->callback = std::move(func);
   item->remove = false;
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
-}
 
 struct RetryArgs {
   std::function<RetryResult(uint8_t)> func;
@@ -162,7 +178,7 @@ void HOT Scheduler::call() {
       this->lock_.unlock();
 
       ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
+                item->get_type_str(), item->get_name(), item->interval, item->last_execution,
                 item->last_execution_major, item->next_execution(), item->next_execution_major());
 
       old_items.push_back(std::move(item));
@@ -223,14 +239,14 @@ void HOT Scheduler::call() {
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
       ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+                item->get_type_str(), item->get_name(), item->interval, item->last_execution, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
       {
-        WarnIfComponentBlockingGuard guard{item->component};
+        WarnIfComponentBlockingGuard guard{item->component, true};
         item->callback();
       }
     }
@@ -250,6 +266,8 @@ void HOT Scheduler::call() {
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        LockGuard guard{this->lock_};
+        this->recycle_item_(std::move(item));
         continue;
       }
 
@@ -262,6 +280,9 @@ void HOT Scheduler::call() {
             item->last_execution_major++;
         }
         this->push_(std::move(item));
+      } else {
+        LockGuard guard{this->lock_};
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -272,6 +293,7 @@ void HOT Scheduler::process_to_add() {
   LockGuard guard{this->lock_};
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->recycle_item_(std::move(it));
       continue;
     }
 
@@ -296,25 +318,29 @@ void HOT Scheduler::cleanup_() {
 }
 void HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+  this->recycle_item_(std::move(this->items_.back()));
   this->items_.pop_back();
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
   LockGuard guard{this->lock_};
   this->to_add_.push_back(std::move(item));
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::cancel_item_(Component *component, const char *name, Scheduler::SchedulerItem::Type type) {
   // obtain lock because this function iterates and can be called from non-loop task context
+  const uint32_t name_hash = fnv1_hash(name);
   LockGuard guard{this->lock_};
   bool ret = false;
   for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type && !it->remove &&
+        strcmp(it->get_name(), name) == 0) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
   }
   for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type &&
+        strcmp(it->get_name(), name) == 0) {
       it->remove = true;
       ret = true;
     }
@@ -322,6 +348,28 @@ bool HOT Scheduler::cancel_item_(Component *component, const std::string &name,
 
   return ret;
 }
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::make_item_() {
+  {
+    LockGuard guard{this->lock_};
+    if (!this->item_pool_.empty()) {
+      auto item = std::move(this->item_pool_.back());
+      this->item_pool_.pop_back();
+      return item;
+    }
+  }
+  return make_unique<SchedulerItem>();
+}
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  if (item == nullptr)
+    return;
+  if (this->item_pool_.size() >= MAX_POOLED_ITEMS)
+    return;
+  // Release whatever the callback captured now rather than when the item is reused; keep the name's buffer.
+  item->callback = nullptr;
+  item->static_name = nullptr;
+  item->name.clear();
+  this->item_pool_.push_back(std::move(item));
+}
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
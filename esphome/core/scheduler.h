@@ -13,9 +13,15 @@ class Component;
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
+  /// Like set_timeout() above, but `name` is stored by pointer without copying, so it must be a string literal.
+  void set_timeout_literal(Component *component, const char *name, uint32_t timeout, std::function<void()> func);
   bool cancel_timeout(Component *component, const std::string &name);
+  bool cancel_timeout(Component *component, const char *name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
+  /// Like set_interval() above, but `name` is stored by pointer without copying, so it must be a string literal.
+  void set_interval_literal(Component *component, const char *name, uint32_t interval, std::function<void()> func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, const char *name);
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
@@ -30,7 +36,11 @@ class Scheduler {
  protected:
   struct SchedulerItem {
     Component *component;
+    // Owned copy of the name, only used if the item wasn't scheduled with a static name.
     std::string name;
+    // Name passed as a string literal, stored without copying. nullptr if `name` is used instead.
+    const char *static_name;
+    uint32_t name_hash;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
@@ -41,6 +51,8 @@ class Scheduler {
     bool remove;
     uint8_t last_execution_major;
 
+    const char *get_name() const { return this->static_name != nullptr ? this->static_name : this->name.c_str(); }
+
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
     inline uint8_t next_execution_major() {
       uint32_t next_exec = this->next_execution();
@@ -67,7 +79,13 @@ class Scheduler {
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  void set_timer_(Component *component, SchedulerItem::Type type, const char *static_name,
+                  const std::string *dynamic_name, uint32_t delay, std::function<void()> func);
+  bool cancel_item_(Component *component, const char *name, SchedulerItem::Type type);
+  /// Take an item from the pool (or allocate a new one). Must not be called with `lock_` held.
+  std::unique_ptr<SchedulerItem> make_item_();
+  /// Return an item to the pool so its storage can be reused. Must be called with `lock_` held.
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -76,6 +94,8 @@ class Scheduler {
   Mutex lock_;
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  /// Finished items kept around so frequently re-armed timeouts don't allocate a new item every time.
+  std::vector<std::unique_ptr<SchedulerItem>> item_pool_;
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
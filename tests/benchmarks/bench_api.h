@@ -0,0 +1,132 @@
+#pragma once
+
+#include "benchmark.h"
+
+#include "esphome/components/api/api_pb2.h"
+#include "esphome/components/api/proto.h"
+
+namespace esphome {
+namespace benchmark {
+
+static void bm_proto_varint_encode(State &state) {
+  std::vector<uint8_t> buffer;
+  buffer.reserve(64);
+  uint32_t value = 0;
+  for (auto _ : state) {
+    buffer.clear();
+    api::ProtoVarInt(value).encode(buffer);
+    value += 977;
+  }
+  do_not_optimize(buffer.data());
+}
+ESPHOME_BENCHMARK(bm_proto_varint_encode);
+
+static void bm_proto_varint_parse(State &state) {
+  std::vector<uint8_t> buffer;
+  api::ProtoVarInt(0x0FFFFFFF).encode(buffer);
+  uint32_t consumed;
+  for (auto _ : state) {
+    auto value = api::ProtoVarInt::parse(buffer.data(), buffer.size(), &consumed);
+    do_not_optimize(value);
+  }
+}
+ESPHOME_BENCHMARK(bm_proto_varint_parse);
+
+static void bm_proto_write_buffer_fields(State &state) {
+  std::vector<uint8_t> buffer;
+  buffer.reserve(128);
+  for (auto _ : state) {
+    buffer.clear();
+    api::ProtoWriteBuffer writer(&buffer);
+    writer.encode_fixed32(1, 0xDEADBEEF);
+    writer.encode_float(2, 21.5f);
+    writer.encode_bool(3, true);
+    writer.encode_string(4, "living_room_temperature", 23);
+    writer.encode_uint32(5, 123456);
+  }
+  do_not_optimize(buffer.data());
+}
+ESPHOME_BENCHMARK(bm_proto_write_buffer_fields);
+
+static void bm_api_sensor_state_encode(State &state) {
+  std::vector<uint8_t> buffer;
+  buffer.reserve(64);
+  api::SensorStateResponse msg;
+  msg.key = 0x12345678;
+  msg.state = 21.5f;
+  for (auto _ : state) {
+    buffer.clear();
+    msg.encode(api::ProtoWriteBuffer(&buffer));
+  }
+  do_not_optimize(buffer.data());
+}
+ESPHOME_BENCHMARK(bm_api_sensor_state_encode);
+
+static void bm_api_list_entities_sensor_encode(State &state) {
+  std::vector<uint8_t> buffer;
+  buffer.reserve(256);
+  api::ListEntitiesSensorResponse msg;
+  msg.object_id = "living_room_temperature";
+  msg.key = 0x12345678;
+  msg.name = "Living Room Temperature";
+  msg.unique_id = "benchmarksensorliving_room_temperature";
+  msg.icon = "mdi:thermometer";
+  msg.unit_of_measurement = "°C";
+  msg.accuracy_decimals = 1;
+  msg.device_class = "temperature";
+  for (auto _ : state) {
+    buffer.clear();
+    msg.encode(api::ProtoWriteBuffer(&buffer));
+  }
+  do_not_optimize(buffer.data());
+}
+ESPHOME_BENCHMARK(bm_api_list_entities_sensor_encode);
+
+static void bm_api_list_entities_services_encode(State &state) {
+  // nested messages, the encoded length of each argument is written in front of it
+  std::vector<uint8_t> buffer;
+  api::ListEntitiesServicesResponse msg;
+  msg.name = "set_brightness";
+  msg.key = 0x12345678;
+  for (const char *name : {"brightness", "transition", "effect"}) {
+    api::ListEntitiesServicesArgument arg;
+    arg.name = name;
+    arg.type = api::enums::SERVICE_ARG_TYPE_FLOAT;
+    msg.args.push_back(arg);
+  }
+  for (auto _ : state) {
+    uint32_t size = 0;
+    msg.calculate_size(size);
+    buffer.clear();
+    buffer.reserve(size);
+    msg.encode(api::ProtoWriteBuffer(&buffer));
+  }
+  do_not_optimize(buffer.data());
+}
+ESPHOME_BENCHMARK(bm_api_list_entities_services_encode);
+
+static void bm_api_light_command_decode(State &state) {
+  api::LightCommandRequest request;
+  request.key = 0x12345678;
+  request.has_state = true;
+  request.state = true;
+  request.has_brightness = true;
+  request.brightness = 0.5f;
+  request.has_rgb = true;
+  request.red = 1.0f;
+  request.green = 0.5f;
+  request.blue = 0.25f;
+  request.has_effect = true;
+  request.effect = "Rainbow";
+  std::vector<uint8_t> buffer;
+  request.encode(api::ProtoWriteBuffer(&buffer));
+  for (auto _ : state) {
+    api::LightCommandRequest msg;
+    msg.decode(buffer.data(), buffer.size());
+    do_not_optimize(msg.brightness);
+  }
+}
+ESPHOME_BENCHMARK(bm_api_light_command_decode);
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "benchmark.h"
+
+#include "esphome/core/color.h"
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/scheduler.h"
+#include "esphome/components/light/esp_hsv_color.h"
+
+namespace esphome {
+namespace benchmark {
+
+// A component that is never registered with App, only used as scheduler owner.
+class BenchmarkComponent : public Component {};
+
+/// Re-arm a named timeout, as debounce/timeout filters do on every state change.
+static void bm_scheduler_rearm_timeout(State &state) {
+  Scheduler scheduler;
+  BenchmarkComponent component;
+  for (auto _ : state) {
+    scheduler.set_timeout_literal(&component, "debounce", 10000, []() {});
+    scheduler.call();
+  }
+}
+ESPHOME_BENCHMARK(bm_scheduler_rearm_timeout);
+
+/// Same as above, but with a name built at runtime.
+static void bm_scheduler_rearm_timeout_string(State &state) {
+  Scheduler scheduler;
+  BenchmarkComponent component;
+  const std::string name = "debounce";
+  for (auto _ : state) {
+    scheduler.set_timeout(&component, name, 10000, []() {});
+    scheduler.call();
+  }
+}
+ESPHOME_BENCHMARK(bm_scheduler_rearm_timeout_string);
+
+/// Scheduler::call() with 150 pending intervals, none of them due.
+static void bm_scheduler_call_idle(State &state) {
+  Scheduler scheduler;
+  std::vector<BenchmarkComponent> components(150);
+  for (auto &component : components)
+    scheduler.set_interval_literal(&component, "update", 3600000, []() {});
+  scheduler.process_to_add();
+  for (auto _ : state) {
+    scheduler.call();
+  }
+}
+ESPHOME_BENCHMARK(bm_scheduler_call_idle);
+
+/// Scheduler::call() running a zero-delay defer every iteration among 150 pending intervals.
+static void bm_scheduler_call_defer(State &state) {
+  Scheduler scheduler;
+  std::vector<BenchmarkComponent> components(150);
+  for (auto &component : components)
+    scheduler.set_interval_literal(&component, "update", 3600000, []() {});
+  uint32_t counter = 0;
+  for (auto _ : state) {
+    scheduler.set_timeout_literal(&components[0], "", 0, [&counter]() { counter++; });
+    scheduler.call();
+  }
+  do_not_optimize(counter);
+}
+ESPHOME_BENCHMARK(bm_scheduler_call_defer);
+
+static void bm_callback_manager_call(State &state) {
+  CallbackManager<void(float)> callbacks;
+  float sum = 0;
+  for (int i = 0; i < 8; i++)
+    callbacks.add([&sum](float value) { sum += value; });
+  for (auto _ : state) {
+    callbacks.call(1.0f);
+  }
+  do_not_optimize(sum);
+  state.set_items_processed(state.iterations() * 8);
+}
+ESPHOME_BENCHMARK(bm_callback_manager_call);
+
+static void bm_color_gradient(State &state) {
+  Color from(255, 64, 0);
+  Color to(0, 128, 255);
+  uint8_t amount = 0;
+  for (auto _ : state) {
+    Color result = from.gradient(to, amount++);
+    do_not_optimize(result.raw_32);
+  }
+}
+ESPHOME_BENCHMARK(bm_color_gradient);
+
+static void bm_hsv_to_rgb(State &state) {
+  uint8_t hue = 0;
+  for (auto _ : state) {
+    Color result = light::ESPHSVColor(hue++, 240, 200).to_rgb();
+    do_not_optimize(result.raw_32);
+  }
+}
+ESPHOME_BENCHMARK(bm_hsv_to_rgb);
+
+}  // namespace benchmark
+}  // namespace esphome
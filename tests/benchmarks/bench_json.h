@@ -0,0 +1,41 @@
+#pragma once
+
+#include "benchmark.h"
+
+#include "esphome/components/json/json_util.h"
+
+namespace esphome {
+namespace benchmark {
+
+/// Roughly the size of a web_server sensor state event.
+static void bm_json_build_sensor_state(State &state) {
+  float value = 21.5f;
+  for (auto _ : state) {
+    std::string json = json::build_json([value](JsonObject root) {
+      root["id"] = "sensor-living_room_temperature";
+      root["name"] = "Living Room Temperature";
+      root["value"] = value;
+      root["state"] = "21.5 °C";
+      root["uom"] = "°C";
+    });
+    do_not_optimize(json.data());
+  }
+}
+ESPHOME_BENCHMARK(bm_json_build_sensor_state);
+
+static void bm_json_parse_light_command(State &state) {
+  const std::string payload =
+      R"({"state":"ON","brightness":128,"color":{"r":255,"g":128,"b":0},"transition":2,"effect":"Rainbow"})";
+  for (auto _ : state) {
+    int brightness = 0;
+    json::parse_json(payload, [&brightness](JsonObject root) -> bool {
+      brightness = root["brightness"];
+      return true;
+    });
+    do_not_optimize(brightness);
+  }
+}
+ESPHOME_BENCHMARK(bm_json_parse_light_command);
+
+}  // namespace benchmark
+}  // namespace esphome
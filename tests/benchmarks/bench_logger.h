@@ -0,0 +1,31 @@
+#pragma once
+
+#include "benchmark.h"
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace benchmark {
+
+/// A log statement that is emitted (formatted, written to the console and passed to log callbacks).
+static void bm_logger_enabled(State &state) {
+  int counter = 0;
+  for (auto _ : state) {
+    esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, "benchmark", __LINE__, "Sending state %.2f with %d decimals", 21.5f,
+                    counter++);
+  }
+}
+ESPHOME_BENCHMARK(bm_logger_enabled);
+
+/// A log statement whose tag is filtered out at runtime by a `logs:` override.
+static void bm_logger_filtered_tag(State &state) {
+  int counter = 0;
+  for (auto _ : state) {
+    esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, "benchmark.quiet", __LINE__, "Sending state %.2f with %d decimals",
+                    21.5f, counter++);
+  }
+}
+ESPHOME_BENCHMARK(bm_logger_filtered_tag);
+
+}  // namespace benchmark
+}  // namespace esphome
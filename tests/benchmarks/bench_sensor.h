@@ -0,0 +1,45 @@
+#pragma once
+
+#include "benchmark.h"
+
+#include "esphome/components/sensor/filter.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome {
+namespace benchmark {
+
+/// publish_state() through a typical calibration + smoothing filter chain.
+static void bm_sensor_filter_chain(State &state) {
+  sensor::Sensor sensor;
+  sensor.set_name("benchmark");
+  sensor.add_filters({
+      new sensor::OffsetFilter(1.5f),
+      new sensor::MultiplyFilter(0.5f),
+      new sensor::SlidingWindowMovingAverageFilter(15, 1, 1),
+      new sensor::ExponentialMovingAverageFilter(0.1f, 1, 1),
+      new sensor::DeltaFilter(0.0f, false),
+  });
+  float value = 0;
+  for (auto _ : state) {
+    sensor.publish_state(value);
+    value += 0.25f;
+  }
+  do_not_optimize(sensor.state);
+}
+ESPHOME_BENCHMARK(bm_sensor_filter_chain);
+
+/// publish_state() without filters, to isolate the callback and logging cost.
+static void bm_sensor_publish_raw(State &state) {
+  sensor::Sensor sensor;
+  sensor.set_name("benchmark");
+  float value = 0;
+  for (auto _ : state) {
+    sensor.publish_state(value);
+    value += 0.25f;
+  }
+  do_not_optimize(sensor.state);
+}
+ESPHOME_BENCHMARK(bm_sensor_publish_raw);
+
+}  // namespace benchmark
+}  // namespace esphome
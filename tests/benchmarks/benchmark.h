@@ -0,0 +1,217 @@
+#pragma once
+
+// Minimal Google-Benchmark-style harness for the host platform.
+//
+// Benchmarks are registered with ESPHOME_BENCHMARK() and written as
+//
+//   static void bm_something(benchmark::State &state) {
+//     ... setup ...
+//     for (auto _ : state) {
+//       ... code under test ...
+//     }
+//   }
+//   ESPHOME_BENCHMARK(bm_something);
+//
+// run_all() runs every benchmark for at least the minimum time and writes the results in Google Benchmark's JSON
+// format, so its tooling (e.g. compare.py) can be used to diff two runs.
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "esphome/core/version.h"
+
+namespace esphome {
+namespace benchmark {
+
+/// Prevent the compiler from optimizing away a value computed in the benchmark loop.
+template<typename T> inline void do_not_optimize(T const &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+class State {
+ public:
+  // Non-trivial so `for (auto _ : state)` doesn't trigger unused variable warnings
+  struct Value {
+    ~Value() {}  // NOLINT(modernize-use-equals-default)
+  };
+  class Iterator {
+   public:
+    Iterator(State *state, uint64_t remaining) : state_(state), remaining_(remaining) {}
+    Value operator*() const { return {}; }
+    Iterator &operator++() {
+      this->remaining_--;
+      return *this;
+    }
+    bool operator!=(const Iterator &other) const {
+      if (this->remaining_ != 0)
+        return true;
+      this->state_->stop_();
+      return false;
+    }
+
+   protected:
+    State *state_;
+    uint64_t remaining_;
+  };
+
+  explicit State(uint64_t iterations) : iterations_(iterations) {}
+
+  Iterator begin() {
+    this->start_();
+    return {this, this->iterations_};
+  }
+  Iterator end() { return {this, 0}; }
+
+  /// Exclude the code between pause_timing() and resume_timing() from the measurement.
+  void pause_timing() {
+    this->real_ns_ += elapsed_ns_(this->real_start_, clock_::now());
+    this->cpu_ns_ += cpu_now_ns_() - this->cpu_start_;
+  }
+  void resume_timing() { this->start_(); }
+
+  /// Report throughput; items are counted over all iterations.
+  void set_items_processed(uint64_t items) { this->items_processed_ = items; }
+
+  uint64_t iterations() const { return this->iterations_; }
+  uint64_t real_ns() const { return this->real_ns_; }
+  uint64_t cpu_ns() const { return this->cpu_ns_; }
+  uint64_t items_processed() const { return this->items_processed_; }
+
+ protected:
+  using clock_ = std::chrono::steady_clock;
+
+  static uint64_t elapsed_ns_(clock_::time_point from, clock_::time_point to) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+  }
+  static uint64_t cpu_now_ns_() {
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+  }
+  void start_() {
+    this->real_start_ = clock_::now();
+    this->cpu_start_ = cpu_now_ns_();
+  }
+  void stop_() { this->pause_timing(); }
+
+  uint64_t iterations_;
+  uint64_t items_processed_{0};
+  uint64_t real_ns_{0};
+  uint64_t cpu_ns_{0};
+  clock_::time_point real_start_{};
+  uint64_t cpu_start_{0};
+};
+
+using BenchmarkFunction = void (*)(State &);
+
+struct Benchmark {
+  const char *name;
+  BenchmarkFunction function;
+};
+
+struct Result {
+  const char *name;
+  uint64_t iterations;
+  double real_time_ns;
+  double cpu_time_ns;
+  double items_per_second;
+};
+
+inline std::vector<Benchmark> &registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+inline bool register_benchmark(const char *name, BenchmarkFunction function) {
+  registry().push_back({name, function});
+  return true;
+}
+
+#define ESPHOME_BENCHMARK(function) \
+  static const bool function##_registered = ::esphome::benchmark::register_benchmark(#function, function)
+
+/// Run a single benchmark, growing the iteration count until it runs for at least min_time_ns.
+inline Result run_benchmark(const Benchmark &benchmark, uint64_t min_time_ns) {
+  static const uint64_t MAX_ITERATIONS = 1000000000ULL;
+  uint64_t iterations = 1;
+  while (true) {
+    State state(iterations);
+    benchmark.function(state);
+    const uint64_t real_ns = std::max<uint64_t>(state.real_ns(), 1);
+    if (real_ns >= min_time_ns || iterations >= MAX_ITERATIONS) {
+      Result result{};
+      result.name = benchmark.name;
+      result.iterations = iterations;
+      result.real_time_ns = double(real_ns) / double(iterations);
+      result.cpu_time_ns = double(state.cpu_ns()) / double(iterations);
+      result.items_per_second = double(state.items_processed()) * 1e9 / double(real_ns);
+      return result;
+    }
+    // Same growth strategy as Google Benchmark: aim for 1.4x the minimum time, but at most 10x per step
+    const double multiplier = std::min(10.0, double(min_time_ns) * 1.4 / double(real_ns));
+    iterations = std::min(MAX_ITERATIONS, std::max(iterations + 1, uint64_t(double(iterations) * multiplier)));
+  }
+}
+
+inline void write_json(FILE *out, const std::vector<Result> &results) {
+  char date[32];
+  time_t now = time(nullptr);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+  fprintf(out, "{\n  \"context\": {\n");
+  fprintf(out, "    \"date\": \"%s\",\n", date);
+  fprintf(out, "    \"executable\": \"esphome-host-benchmarks\",\n");
+  fprintf(out, "    \"esphome_version\": \"%s\",\n", ESPHOME_VERSION);
+  fprintf(out, "    \"library_build_type\": \"release\"\n");
+  fprintf(out, "  },\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &r = results[i];
+    fprintf(out, "    {\n");
+    fprintf(out, "      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n      \"run_type\": \"iteration\",\n", r.name,
+            r.name);
+    fprintf(out, "      \"iterations\": %" PRIu64 ",\n", r.iterations);
+    fprintf(out, "      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n", r.real_time_ns, r.cpu_time_ns);
+    if (r.items_per_second > 0)
+      fprintf(out, "      \"items_per_second\": %.3f,\n", r.items_per_second);
+    fprintf(out, "      \"time_unit\": \"ns\"\n    }%s\n", i + 1 < results.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+}
+
+/** Run all registered benchmarks whose name contains \p filter.
+ *
+ * Results are printed as a table to stderr and written as JSON to \p out_path (if not empty).
+ *
+ * @return Whether the results could be written.
+ */
+inline bool run_all(const std::string &out_path, const std::string &filter = "", uint64_t min_time_ns = 200000000ULL) {
+  std::vector<Result> results;
+  fprintf(stderr, "%-48s %14s %14s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations");
+  for (const auto &benchmark : registry()) {
+    if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos)
+      continue;
+    Result result = run_benchmark(benchmark, min_time_ns);
+    fprintf(stderr, "%-48s %14.1f %14.1f %12" PRIu64 "\n", result.name, result.real_time_ns, result.cpu_time_ns,
+            result.iterations);
+    results.push_back(result);
+  }
+
+  if (out_path.empty())
+    return true;
+  FILE *out = fopen(out_path.c_str(), "w");
+  if (out == nullptr) {
+    fprintf(stderr, "Could not open %s for writing\n", out_path.c_str());
+    return false;
+  }
+  write_json(out, results);
+  fclose(out);
+  fprintf(stderr, "Results written to %s\n", out_path.c_str());
+  return true;
+}
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,30 @@
+#pragma once
+
+// Entry point included from host.yaml, see script/run_benchmarks.
+
+#include <cstdlib>
+
+#include "benchmark.h"
+#include "bench_api.h"
+#include "bench_core.h"
+#include "bench_json.h"
+#include "bench_logger.h"
+#include "bench_sensor.h"
+
+namespace esphome {
+namespace benchmark {
+
+/// Run the benchmarks selected by $ESPHOME_BENCHMARK_FILTER and write the results to $ESPHOME_BENCHMARK_OUT.
+inline void run_from_environment() {
+  const char *out = getenv("ESPHOME_BENCHMARK_OUT");
+  const char *filter = getenv("ESPHOME_BENCHMARK_FILTER");
+  const char *min_time_ms = getenv("ESPHOME_BENCHMARK_MIN_TIME_MS");
+  uint64_t min_time_ns = 200000000ULL;
+  if (min_time_ms != nullptr)
+    min_time_ns = strtoull(min_time_ms, nullptr, 10) * 1000000ULL;
+  bool ok = run_all(out != nullptr ? out : "", filter != nullptr ? filter : "", min_time_ns);
+  exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,161 @@
+import base64
+import struct
+
+import pytest
+
+from esphome.components.logger.deferred_log import DeferredLogDecoder
+
+RODATA_ADDRESS = 0x3F400000
+
+
+def _elf_with_strings(path, strings):
+    """Write a minimal 32-bit little endian ELF with the strings in an allocated section."""
+    rodata = b""
+    addresses = {}
+    for string in strings:
+        addresses[string] = RODATA_ADDRESS + len(rodata)
+        rodata += string.encode() + b"\0"
+
+    header_size = 52
+    section_header_size = 40
+    section_headers_offset = header_size + len(rodata)
+    header = b"\x7fELF" + bytes([1, 1, 1]) + bytes(9)
+    header += struct.pack(
+        "<HHIIIIIHHHHHH",
+        2,  # e_type
+        0x5E,  # e_machine
+        1,  # e_version
+        0,  # e_entry
+        0,  # e_phoff
+        section_headers_offset,
+        0,  # e_flags
+        header_size,
+        0,  # e_phentsize
+        0,  # e_phnum
+        section_header_size,
+        2,  # e_shnum
+        0,  # e_shstrndx
+    )
+    null_section = bytes(section_header_size)
+    rodata_section = struct.pack(
+        "<IIIIIIIIII",
+        0,  # sh_name
+        1,  # SHT_PROGBITS
+        0x2,  # SHF_ALLOC
+        RODATA_ADDRESS,
+        header_size,
+        len(rodata),
+        0,
+        0,
+        4,
+        0,
+    )
+    path.write_bytes(header + rodata + null_section + rodata_section)
+    return addresses
+
+
+def _record(level, line, tag_address, format_address, args=b""):
+    record = struct.pack("<BHII", level, line, tag_address, format_address) + args
+    return "~D" + base64.b64encode(record).decode()
+
+
+@pytest.fixture
+def decoder_and_strings(tmp_path):
+    path = tmp_path / "firmware.elf"
+    addresses = _elf_with_strings(
+        path,
+        [
+            "sensor",
+            "Value %d, %u, 0x%02X",
+            "%lld %hhd %c",
+            "'%s': %.2f%s",
+            "%*d|%.*s",
+            "100%% done",
+        ],
+    )
+    return DeferredLogDecoder(path), addresses
+
+
+def _decode(decoder, addresses, format_, args=b"", level=5, line=42):
+    text = decoder.decode(
+        _record(level, line, addresses["sensor"], addresses[format_], args)
+    )
+    return text.removeprefix("\033[0;36m").removesuffix("\033[0m")
+
+
+def test_integer_conversions(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    args = struct.pack("<iii", -5, -1, 0xAB)
+    assert (
+        _decode(decoder, addresses, "Value %d, %u, 0x%02X", args)
+        == "[D][sensor:042]: Value -5, 4294967295, 0xAB"
+    )
+
+
+def test_length_modifiers_and_char(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    # char and short arguments arrive promoted to int
+    args = struct.pack("<qii", -(1 << 40), 0x1FF, ord("x"))
+    assert (
+        _decode(decoder, addresses, "%lld %hhd %c", args)
+        == f"[D][sensor:042]: {-(1 << 40)} -1 x"
+    )
+
+
+def test_strings_and_floats(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    args = b"temp\0" + struct.pack("<d", 21.456) + b" C\0"
+    assert (
+        _decode(decoder, addresses, "'%s': %.2f%s", args)
+        == "[D][sensor:042]: 'temp': 21.46 C"
+    )
+
+
+def test_star_width_and_precision(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    args = struct.pack("<ii", 4, 7) + struct.pack("<i", 2) + b"abc\0"
+    assert _decode(decoder, addresses, "%*d|%.*s", args) == "[D][sensor:042]:    7|ab"
+
+
+def test_percent_escape(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    assert _decode(decoder, addresses, "100%% done") == "[D][sensor:042]: 100% done"
+
+
+def test_truncated_arguments(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    # the record ends after the first argument
+    args = struct.pack("<i", 7)
+    assert (
+        _decode(decoder, addresses, "Value %d, %u, 0x%02X", args)
+        == "[D][sensor:042]: Value 7, ?, 0x?"
+    )
+    assert (
+        _decode(decoder, addresses, "'%s': %.2f%s", b"unterminated")
+        == "[D][sensor:042]: '?': ??"
+    )
+
+
+def test_truncated_header(decoder_and_strings):
+    decoder, _ = decoder_and_strings
+    record = "~D" + base64.b64encode(struct.pack("<BH", 5, 42)).decode()
+    assert decoder.decode(record) == "<truncated log record>"
+
+
+def test_unknown_addresses(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    text = decoder.decode(_record(5, 7, 0x12345678, 0x40000000))
+    assert (
+        text
+        == "\033[0;36m[D][0x12345678:007]: <unknown format string at 0x40000000>\033[0m"
+    )
+
+
+def test_lines_without_records(decoder_and_strings):
+    decoder, addresses = decoder_and_strings
+    assert decoder.decode("[I][app:100]: Running") == "[I][app:100]: Running"
+    # not valid base64, left as is
+    assert decoder.decode("~DA") == "~DA"
+    # text around the record is kept
+    line = "12:00:00 " + _record(5, 1, addresses["sensor"], addresses["100%% done"])
+    assert decoder.decode(line).startswith("12:00:00 \033[0;36m[D][sensor:001]: 100%")
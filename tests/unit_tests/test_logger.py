@@ -0,0 +1,64 @@
+from hypothesis import given
+from hypothesis.strategies import dictionaries, integers, text
+import pytest
+
+from esphome.components.logger import build_tag_level_table, tag_hash
+
+
+@pytest.mark.parametrize(
+    "tag, expected",
+    (
+        # computed by tag_hash() in logger.cpp
+        ("", 2166136261),
+        ("sensor", 1978014491),
+        ("wifi", 1402839958),
+        ("api.connection", 1225826351),
+        ("sensor.filter", 3789614197),
+        ("logger", 3169000693),
+        # non-ASCII bytes are hashed unsigned on every platform
+        ("ä", 3463954928),
+        ("müll", 2108487283),
+    ),
+)
+def test_tag_hash(tag, expected):
+    assert tag_hash(tag) == expected
+
+
+def _lookup(table, tag):
+    """Look up a tag the way Logger::level_for() does."""
+    mask = len(table) - 1
+    index = tag_hash(tag) & mask
+    while table[index] is not None:
+        if table[index][0] == tag:
+            return table[index][1]
+        index = (index + 1) & mask
+    return None
+
+
+@given(dictionaries(text(min_size=1), integers(min_value=0, max_value=7), min_size=1))
+def test_build_tag_level_table(levels):
+    table = build_tag_level_table(levels)
+
+    size = len(table)
+    assert size & (size - 1) == 0
+    # a lookup of an unknown tag must end at a free slot
+    assert table.count(None) >= 1
+    assert sorted(entry for entry in table if entry is not None) == sorted(
+        levels.items()
+    )
+    for tag, level in levels.items():
+        assert _lookup(table, tag) == level
+
+
+def test_build_tag_level_table_collisions():
+    # all of these land in the same slot of a table of 8
+    tags = [tag for tag in (f"tag{i}" for i in range(1000)) if tag_hash(tag) % 8 == 3]
+    levels = {tag: i % 8 for i, tag in enumerate(tags[:4])}
+
+    table = build_tag_level_table(levels)
+
+    assert len(table) == 8
+    assert table.count(None) == 4
+    for tag, level in levels.items():
+        assert _lookup(table, tag) == level
+    assert _lookup(table, "unknown") is None